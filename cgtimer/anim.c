@@ -0,0 +1,98 @@
+/*
+ * anim.c
+ *
+ */ 
+
+#include "anim.h"
+#include "tick.h"
+
+// starts an animation to move the distance in the given frames, the last ease_frames decelerate.
+//
+// cruising for C frames then easing for E frames covers the distance D when the
+// velocity is 2D / (2C + E), the ease-out then starts at the cruise velocity.
+void anim_start(anim_t * anim, uint16_t distance, uint16_t frames, uint8_t ease_frames)
+{
+	if (frames == 0)
+		frames = 1;
+
+	if (ease_frames > frames)
+		ease_frames = frames;
+
+	uint16_t cruise_frames = frames - ease_frames;
+	uint32_t velocity = ((uint32_t)distance << (ANIM_FRACTION_BITS + 1)) / (2 * cruise_frames + ease_frames);
+
+	anim->pos = 0;
+	anim->end = (uint32_t)distance << ANIM_FRACTION_BITS;
+	anim->ease_distance = anim->end;
+	anim->velocity = velocity > UINT16_MAX ? UINT16_MAX : velocity;
+	anim->frames = frames;
+	anim->ease_frames = ease_frames;
+}
+
+// moves the animation on by a number of frames, returns false once it has stopped.
+bool anim_step(anim_t * anim, uint8_t frames)
+{
+	for (; frames != 0 && anim->frames != 0; frames--)
+	{
+		uint16_t k = --anim->frames;
+
+		if (k >= anim->ease_frames)
+		{
+			// cruise.
+			anim->pos += anim->velocity;
+
+			if (anim->pos > anim->end)
+				anim->pos = anim->end;
+
+			if (k == anim->ease_frames)
+				anim->ease_distance = anim->end - anim->pos;
+		}
+		else
+		{
+			// ease-out, the distance left falls with the square of the frames left.
+			uint32_t left = anim->ease_distance * k / anim->ease_frames * k / anim->ease_frames;
+			anim->pos = anim->end - left;
+		}
+
+		// the last frame stops exactly at the end, whatever the rounding.
+		if (k == 0)
+			anim->pos = anim->end;
+	}
+
+	return anim->frames != 0;
+}
+
+// returns the whole pixels moved.
+uint16_t anim_pixels(anim_t const * anim)
+{
+	return anim->pos >> ANIM_FRACTION_BITS;
+}
+
+// returns true until the animation has stopped.
+bool anim_running(anim_t const * anim)
+{
+	return anim->frames != 0;
+}
+
+// sets the deadline of the first frame, one frame period from now.
+void anim_clock_start(uint16_t * deadline)
+{
+	*deadline = tick_now() + ANIM_FRAME_MS;
+}
+
+// returns the frames due (0 until the deadline is reached) and moves the deadline to the next frame.
+// frames missed while busy are returned too, so the animation keeps to time.
+uint8_t anim_frames_due(uint16_t * deadline)
+{
+	uint16_t now = tick_now();
+
+	if ((int16_t)(now - *deadline) < 0)
+		return 0;
+
+	uint16_t late = (now - *deadline) / ANIM_FRAME_MS;
+	uint8_t frames = late < UINT8_MAX ? late + 1 : UINT8_MAX;
+
+	*deadline += (late + 1) * ANIM_FRAME_MS;
+
+	return frames;
+}
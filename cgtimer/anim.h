@@ -0,0 +1,56 @@
+/*
+ * anim.h
+ *
+ * Frame paced animation using fixed point motion.
+ *
+ * An animation moves a distance (pixels) over a number of frames.
+ * It cruises at a constant velocity then eases out (decelerates) to stop exactly at the distance.
+ * Frames are paced by the millisecond tick (see tick.h), so an animation takes the same time
+ * whatever the clock speed or display latency. When frames are missed the animation catches up.
+ *
+ */ 
+
+
+#ifndef ANIM_H_
+#define ANIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// frame period in milliseconds (build-time option).
+#ifndef ANIM_FRAME_MS
+#define ANIM_FRAME_MS 20
+#endif
+
+// fixed point fraction bits of positions and velocities.
+#define ANIM_FRACTION_BITS 8
+
+typedef struct
+{
+	uint32_t pos;				// fixed point pixels moved.
+	uint32_t end;				// fixed point pixels moved at the stop.
+	uint32_t ease_distance;		// fixed point pixels left when the ease-out began.
+	uint16_t velocity;			// fixed point pixels per frame while cruising.
+	uint16_t frames;			// frames left until the stop.
+	uint8_t ease_frames;		// frames of ease-out before the stop.
+}anim_t;
+
+// starts an animation to move the distance in the given frames, the last ease_frames decelerate.
+void anim_start(anim_t * anim, uint16_t distance, uint16_t frames, uint8_t ease_frames);
+
+// moves the animation on by a number of frames, returns false once it has stopped.
+bool anim_step(anim_t * anim, uint8_t frames);
+
+// returns the whole pixels moved.
+uint16_t anim_pixels(anim_t const * anim);
+
+// returns true until the animation has stopped.
+bool anim_running(anim_t const * anim);
+
+// sets the deadline of the first frame, one frame period from now.
+void anim_clock_start(uint16_t * deadline);
+
+// returns the frames due (0 until the deadline is reached) and moves the deadline to the next frame.
+uint8_t anim_frames_due(uint16_t * deadline);
+
+#endif /* ANIM_H_ */
@@ -0,0 +1,157 @@
+/*
+ * app.c
+ *
+ */ 
+
+#include "app.h"
+#include <stddef.h>
+#include <avr/pgmspace.h>
+#include "sched.h"
+#include "timer.h"
+#include "slotmachine.h"
+
+// the applications in the order button2 cycles through them, the first is shown at boot.
+// the slot machine runs its frame task itself, only while the reels spin.
+static const app_t g_apps[] PROGMEM =
+{
+	{
+		.config = timer_config,
+		.enter = timer_show,
+		.leave = timer_hide,
+		.process = timer_process,
+		.process_ms = TIMER_REDRAW_MS,
+		.action = timer_action,
+		.alt_action = timer_alt_action,
+		.long_action = timer_reset,
+		.busy = timer_counting,
+		.save = timer_save,
+		.restore = timer_restore,
+	},
+	{
+		.config = slot_config,
+		.enter = slot_show,
+		.leave = slot_hide,
+		.process = NULL,
+		.process_ms = 0,
+		.action = slot_action,
+		.alt_action = NULL,
+		.long_action = NULL,
+		.busy = slot_spinning,
+		.save = slot_save,
+		.restore = slot_restore,
+	},
+};
+
+#define APPS (sizeof(g_apps) / sizeof(g_apps[0]))
+
+// reads a hook of an application from flash.
+#define APP_HOOK(app, hook) ((__typeof__(g_apps[0].hook))pgm_read_ptr(&g_apps[app].hook))
+
+// the application shown.
+static uint8_t g_app = 0;
+
+// scheduler task running each application's process hook.
+static uint8_t g_process_task[APPS];
+
+// function declarations.
+void app_switch(uint8_t app);
+
+void app_config(void)
+{
+	for (uint8_t app = 0; app != APPS; app++)
+	{
+		APP_HOOK(app, config)();
+
+		void (*process)(void) = APP_HOOK(app, process);
+
+		if (process != NULL)
+			g_process_task[app] = sched_add(process, pgm_read_word(&g_apps[app].process_ms));
+		else
+			g_process_task[app] = SCHED_TASKS;
+	}
+}
+
+void app_show(void)
+{
+	APP_HOOK(g_app, enter)();
+
+	if (g_process_task[g_app] != SCHED_TASKS)
+		sched_start(g_process_task[g_app], pgm_read_word(&g_apps[g_app].process_ms));
+}
+
+void app_hide(void)
+{
+	if (g_process_task[g_app] != SCHED_TASKS)
+		sched_stop(g_process_task[g_app]);
+
+	void (*leave)(void) = APP_HOOK(g_app, leave);
+
+	if (leave != NULL)
+		leave();
+}
+
+void app_next(void)
+{
+	app_switch(g_app == APPS - 1 ? 0 : g_app + 1);
+}
+
+void app_previous(void)
+{
+	app_switch(g_app == 0 ? APPS - 1 : g_app - 1);
+}
+
+void app_switch(uint8_t app)
+{
+	app_hide();
+	g_app = app;
+	app_show();
+}
+
+void app_action(void)
+{
+	APP_HOOK(g_app, action)();
+}
+
+void app_alt_action(uint16_t pressed_ms)
+{
+	void (*alt_action)(uint16_t) = APP_HOOK(g_app, alt_action);
+
+	if (alt_action != NULL)
+		alt_action(pressed_ms);
+}
+
+void app_long_action(void)
+{
+	void (*long_action)(void) = APP_HOOK(g_app, long_action);
+
+	if (long_action != NULL)
+		long_action();
+}
+
+// a hidden application can still be busy, the timer counts while the slot machine is shown.
+bool app_busy(void)
+{
+	for (uint8_t app = 0; app != APPS; app++)
+	{
+		if (APP_HOOK(app, busy)())
+			return true;
+	}
+
+	return false;
+}
+
+void app_save(persist_state_t * state)
+{
+	for (uint8_t app = 0; app != APPS; app++)
+	{
+		APP_HOOK(app, save)(state);
+	}
+}
+
+void app_restore(persist_state_t const * state)
+{
+	for (uint8_t app = 0; app != APPS; app++)
+	{
+		APP_HOOK(app, restore)(state);
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * app.h
+ *
+ * The applications, a table in flash of the hooks each one provides.
+ *
+ * One application is shown at a time, the buttons act on it and its process task redraws it.
+ * Button2 cycles through the applications in the order of the table, so adding an application
+ * is an entry in the table (app.c), main only calls the app_ functions.
+ *
+ * An application declares the tick it needs by the period of its process task, the task only
+ * runs while the application is shown.
+ *
+ * Any application can keep the MCU from powering down, shown or not, the timer keeps counting
+ * while the slot machine is shown.
+ *
+ */ 
+
+
+#ifndef APP_H_
+#define APP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "persist.h"
+
+// the hooks of an application, the ones marked optional may be NULL.
+typedef struct
+{
+	void (*config)(void);						// configures the application at boot.
+	void (*enter)(void);						// draws the application when it is shown.
+	void (*leave)(void);						// stops what only runs while shown, optional.
+	void (*process)(void);						// redraws it while shown, optional.
+	uint16_t process_ms;						// milliseconds between process runs.
+	void (*action)(void);						// button1 pressed.
+	void (*alt_action)(uint16_t pressed_ms);	// button3 pressed at the tick time (see tick.h), optional.
+	void (*long_action)(void);					// button1 held (long press), optional.
+	bool (*busy)(void);							// true while the MCU must not power down.
+	void (*save)(persist_state_t * state);		// stores its state kept over a power cycle.
+	void (*restore)(persist_state_t const * state);	// restores it at boot.
+}app_t;
+
+// configures the applications and adds their process tasks to the scheduler.
+void app_config(void);
+
+// shows the current application, its process task starts.
+void app_show(void);
+
+// hides the current application, its process task stops.
+void app_hide(void);
+
+// hides the current application and shows the next or previous one.
+void app_next(void);
+void app_previous(void);
+
+// the buttons acting on the current application.
+void app_action(void);
+void app_alt_action(uint16_t pressed_ms);
+void app_long_action(void);
+
+// returns true while any application is busy, shown or not.
+bool app_busy(void);
+
+// the state of every application kept over a power cycle.
+void app_save(persist_state_t * state);
+void app_restore(persist_state_t const * state);
+
+#endif /* APP_H_ */
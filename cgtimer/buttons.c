@@ -0,0 +1,173 @@
+/*
+ * buttons.c
+ *
+ */ 
+
+#include "buttons.h"
+#include "tick.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+// event queue size (a power of 2).
+#define QUEUE_SIZE 8
+#define QUEUE_MASK (QUEUE_SIZE - 1)
+
+// samples held for a long press and between auto repeats.
+#define LONG_SAMPLES (BUTTON_LONG_MS / BUTTON_SAMPLE_MS)
+#define REPEAT_SAMPLES (BUTTON_REPEAT_MS / BUTTON_SAMPLE_MS)
+
+typedef struct
+{
+	uint8_t pin;			// PORTC bit.
+	uint8_t integrator;		// 0 is up, BUTTON_INTEGRATOR is down.
+	bool down;				// debounced state.
+	bool ignore;			// no events until released.
+	uint16_t held;			// samples held down.
+}button_t;
+
+static button_t g_buttons[BUTTONS];
+
+// events, written by the tick interrupt at the head, read by the main loop at the tail.
+// the entries are volatile so they are stored before the head publishes them.
+static volatile uint8_t g_queue[QUEUE_SIZE];
+static volatile uint16_t g_queue_ms[QUEUE_SIZE];
+static volatile uint8_t g_queue_head = 0;
+static volatile uint8_t g_queue_tail = 0;
+
+// milliseconds until the next sample.
+static uint8_t g_sample_ms = BUTTON_SAMPLE_MS;
+
+// function declarations.
+void sample(uint8_t i);
+void push(uint8_t i, uint8_t type);
+
+
+// configures the button pins (PORTC) for input, buttons are active low.
+void buttons_config(uint8_t pin0, uint8_t pin1, uint8_t pin2)
+{
+	g_buttons[0].pin = pin0;
+	g_buttons[1].pin = pin1;
+	g_buttons[2].pin = pin2;
+
+	for (uint8_t i = 0; i != BUTTONS; i++)
+	{
+		DDRC &= ~(1 << g_buttons[i].pin);
+	}
+}
+
+// samples the buttons, called from the tick interrupt every millisecond.
+void buttons_tick(void)
+{
+	if (--g_sample_ms != 0)
+		return;
+
+	g_sample_ms = BUTTON_SAMPLE_MS;
+
+	for (uint8_t i = 0; i != BUTTONS; i++)
+	{
+		sample(i);
+	}
+}
+
+// moves the button's integrator towards the pin state and queues the events.
+void sample(uint8_t i)
+{
+	button_t * button = &g_buttons[i];
+	bool pin_down = !(PINC & (1 << button->pin));
+
+	if (pin_down)
+	{
+		if (button->integrator != BUTTON_INTEGRATOR)
+			button->integrator++;
+	}
+	else if (button->integrator != 0)
+	{
+		button->integrator--;
+	}
+
+	if (!button->down && button->integrator == BUTTON_INTEGRATOR)
+	{
+		button->down = true;
+		button->held = 0;
+		push(i, BUTTON_PRESS);
+	}
+	else if (button->down && button->integrator == 0)
+	{
+		button->down = false;
+		push(i, BUTTON_RELEASE);
+		button->ignore = false;
+	}
+	else if (!button->down && button->integrator == 0)
+	{
+		// a held button that never debounced down has been released.
+		button->ignore = false;
+	}
+	else if (button->down)
+	{
+		button->held++;
+
+		if (button->held == LONG_SAMPLES)
+		{
+			push(i, BUTTON_LONG);
+		}
+		else if (button->held == LONG_SAMPLES + REPEAT_SAMPLES)
+		{
+			push(i, BUTTON_REPEAT);
+			button->held = LONG_SAMPLES;
+		}
+	}
+}
+
+// queues an event, when the queue is full the event is lost.
+void push(uint8_t i, uint8_t type)
+{
+	if (g_buttons[i].ignore)
+		return;
+
+	uint8_t head = g_queue_head;
+	uint8_t next = (head + 1) & QUEUE_MASK;
+
+	if (next == g_queue_tail)
+		return;
+
+	g_queue[head] = (type << 4) | i;
+	g_queue_ms[head] = tick_now();
+	g_queue_head = next;
+}
+
+// takes the next event, returns false when there are none.
+bool buttons_event(button_event_t * event)
+{
+	uint8_t tail = g_queue_tail;
+
+	if (tail == g_queue_head)
+		return false;
+
+	uint8_t data = g_queue[tail];
+	event->ms = g_queue_ms[tail];
+	g_queue_tail = (tail + 1) & QUEUE_MASK;
+
+	event->button = data & 0x0F;
+	event->type = data >> 4;
+
+	return true;
+}
+
+// discards queued events, buttons held down give no events until released.
+void buttons_ignore_held(void)
+{
+	uint8_t sreg = SREG;
+	cli();
+
+	for (uint8_t i = 0; i != BUTTONS; i++)
+	{
+		button_t * button = &g_buttons[i];
+
+		// a press not yet debounced is ignored too.
+		button->ignore = button->down || !(PINC & (1 << button->pin));
+	}
+
+	g_queue_tail = g_queue_head;
+
+	SREG = sreg;
+}
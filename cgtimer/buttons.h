@@ -0,0 +1,60 @@
+/*
+ * buttons.h
+ *
+ * Debounced buttons sampled by the millisecond tick interrupt (see tick.c).
+ *
+ * Each sample moves a button's integrator towards down or up, the button changes state
+ * when the integrator reaches the end. Changes are queued as events for the main loop,
+ * which reads them with buttons_event() without waiting.
+ *
+ * The queue has a single producer (the interrupt) and a single consumer (the main loop),
+ * each side only writes its own index so no locking is needed.
+ *
+ * Events carry the tick time they were detected at, so the main loop's latency in reading
+ * them can be allowed for.
+ *
+ */ 
+
+
+#ifndef BUTTONS_H_
+#define BUTTONS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BUTTONS 3
+
+// milliseconds between samples and the samples to change state (debounce time).
+#define BUTTON_SAMPLE_MS 5
+#define BUTTON_INTEGRATOR 4
+
+// milliseconds held for a long press and between auto repeats after it.
+#define BUTTON_LONG_MS 1000
+#define BUTTON_REPEAT_MS 200
+
+// event types.
+#define BUTTON_PRESS 0
+#define BUTTON_RELEASE 1
+#define BUTTON_LONG 2
+#define BUTTON_REPEAT 3
+
+typedef struct
+{
+	uint8_t button;		// 0 to BUTTONS-1.
+	uint8_t type;		// BUTTON_PRESS, BUTTON_RELEASE, BUTTON_LONG or BUTTON_REPEAT.
+	uint16_t ms;		// tick time detected (see tick.h).
+}button_event_t;
+
+// configures the button pins (PORTC) for input, buttons are active low.
+void buttons_config(uint8_t pin0, uint8_t pin1, uint8_t pin2);
+
+// samples the buttons, called from the tick interrupt every millisecond.
+void buttons_tick(void);
+
+// takes the next event, returns false when there are none.
+bool buttons_event(button_event_t * event);
+
+// discards queued events, buttons held down give no events until released.
+void buttons_ignore_held(void);
+
+#endif /* BUTTONS_H_ */
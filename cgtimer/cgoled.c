@@ -12,13 +12,15 @@
  *
  */
 
-#include "cgoled.h"
-#include <avr/io.h>
-
 #ifndef F_CPU				// if F_CPU was not defined in Project -> Properties
 #define F_CPU 1000000UL		// define it now as 1 MHz unsigned long
 #endif
 
+#include "cgoled.h"
+#include <avr/pgmspace.h>
+#include "oledhal.h"
+#include "clock.h"
+
 
 // Note. Example addresses below are hex.
 
@@ -79,10 +81,68 @@
 // For graphics				(1 << 1) | 1
 #define CMD_MODE_GFX_FLAG 0x03
 
+// Display on/off control bits (power, cursor, blink).
+#define CMD_DISPLAY_CONTROL_MASK 0x07
+
+
+// Worst case execution time in micro seconds, all but the slow instructions.
+// (clear display and cursor home always check the busy flag)
+#define EXEC_US 40
+
+// Clock ticks to wait in timed mode, the extra tick covers the clock phase.
+#define EXEC_TICKS ((EXEC_US * 1000UL + OLED_HAL_CLOCK_NS - 1) / OLED_HAL_CLOCK_NS + 1)
+
+// Wait for the busy flag instead of the clock.
+#define WAIT_BUSY_FLAG 0xFF
+
+// timed mode state.
+static bool g_timed_mode = false;
+static uint8_t g_last_write = 0;
+static uint8_t g_wait_ticks = WAIT_BUSY_FLAG;
+
+// Queued writes (power of 2).
+#define QUEUE_SIZE 64
+#define QUEUE_MASK (QUEUE_SIZE - 1)
+
+// Clock ticks between busy flag checks after a slow instruction.
+#define QUEUE_POLL_TICKS 250
+
+// Fewest clock ticks the interrupt can be scheduled ahead, covers reading TCNT2 to writing OCR2A
+// (a tick is a cycle at 1 MHz).
+#define QUEUE_MIN_TICKS 8
+
+// queue of pending writes, data with the RS bit of each entry in a bitmap.
+// written by the main loop at the head, drained by the clock interrupt at the tail.
+// the entries are volatile so they are stored before the head publishes them.
+static volatile uint8_t g_queue_data[QUEUE_SIZE];
+static volatile uint8_t g_queue_rs[QUEUE_SIZE / 8];
+static volatile uint8_t g_queue_head = 0;
+static volatile uint8_t g_queue_tail = 0;
+static volatile bool g_queue_running = false;
+static bool g_queue_mode = false;
+
+// previous queued write was a slow instruction, check the busy flag.
+// set by oled_queue_mode() as well as the clock interrupt.
+static volatile bool g_queue_poll = false;
+
+// Shadow of the graphics address, the last GXA and GYA commands written
+// and updated by the auto increment.  0 when unknown.
+static uint8_t g_gxa_cmd = 0;
+static uint8_t g_gya_cmd = 0;
+static bool g_graphics = false;
+
 
 // private function declarations.
 void busy_wait();
-void set_data_bus(uint8_t data);
+bool busy_check();
+void ready_wait();
+void write_timed(uint8_t wait_ticks);
+void queue_push(bool rs, uint8_t data);
+void cursor_track(bool rs, uint8_t data);
+void cursor_advance(uint8_t n);
+void write_data_run(uint8_t const * src, uint8_t step, uint8_t n);
+void set_character(uint8_t char_n, uint8_t const * const patterns, bool progmem);
+static inline void bus_write(bool rs, uint8_t data);
 uint8_t get_ddram_address_n1(uint8_t column_n, uint8_t row_n);
 uint8_t get_cgram_address(uint8_t char_n, uint8_t row_n);
 uint8_t get_gxa_address(uint8_t x);
@@ -91,20 +151,7 @@ uint8_t get_gya_address(uint8_t cga);
 // Sets the ports using the defines declared in the header file.
 void oled_config()
 {
-	// setup port D pins for output.
-	OLED_DDR_DB0 |= (1 << OLED_DB0);
-	OLED_DDR_DB1 |= (1 << OLED_DB1);
-	OLED_DDR_DB2 |= (1 << OLED_DB2);
-	OLED_DDR_DB3 |= (1 << OLED_DB3);
-	OLED_DDR_DB4 |= (1 << OLED_DB4);
-	OLED_DDR_DB5 |= (1 << OLED_DB5);
-	OLED_DDR_DB6 |= (1 << OLED_DB6);
-	OLED_DDR_DB7 |= (1 << OLED_DB7);
-
-	// setup Port B pins for output.
-	OLED_DDR_RS |= (1 << OLED_RS);
-	OLED_DDR_RW |= (1 << OLED_RW);
-	OLED_DDR_EN |= (1 << OLED_EN);
+	oled_hal_config();
 }
 
 // clears the display using the hardware feature.
@@ -120,11 +167,7 @@ void oled_blank()
 	for (uint8_t row = 0; row != OLED_BYTE_ROWS; ++row)
 	{
 		oled_set_coordinates(1, row + 1);
-
-		for (uint8_t i = 0; i != OLED_PIXEL_COLUMNS; i++)
-		{
-			oled_write_data(0x00);
-		}		
+		oled_fill_data(0x00, OLED_PIXEL_COLUMNS);
 	}
 }
 
@@ -146,6 +189,12 @@ void oled_graphics_mode()
 	oled_write_cmd(CMD_MODE | CMD_MODE_GFX | CMD_MODE_POWER | CMD_MODE_GFX_FLAG);
 }
 
+// switch to character mode.
+void oled_character_mode()
+{
+	oled_write_cmd(CMD_MODE | CMD_MODE_POWER | CMD_MODE_GFX_FLAG);
+}
+
 
 // switch the OLED on.
 void oled_power_on()
@@ -169,12 +218,33 @@ void oled_write_character(uint8_t character, uint8_t column, uint8_t row)
 	oled_write_data(character);
 }
 
+// write n characters from the given position, auto increment moves along the row.
+void oled_write_characters(uint8_t const * characters, uint8_t n, uint8_t column, uint8_t row)
+{
+	uint8_t addr = get_ddram_address_n1(column, row);
+	oled_write_cmd(CMD_DDRAM | addr);
+
+	oled_write_data_n(characters, n);
+}
+
 
 // sets a user defined character in the displays CGRAM.
 // 8 user definable characters (char_n 1 to 8).
 // characters are 5x8 (7 + cursor row).
 // patterns pointer must point to 8 uint8_t rows.
 void oled_set_character(uint8_t char_n, uint8_t const * const patterns)
+{
+	set_character(char_n, patterns, false);
+}
+
+// sets a user defined character from patterns held in program memory (PROGMEM).
+void oled_set_character_P(uint8_t char_n, uint8_t const * const patterns)
+{
+	set_character(char_n, patterns, true);
+}
+
+// sets a user defined character from data memory or program memory (progmem).
+void set_character(uint8_t char_n, uint8_t const * const patterns, bool progmem)
 {
 	uint8_t addr;
 	uint8_t ptn;
@@ -184,70 +254,146 @@ void oled_set_character(uint8_t char_n, uint8_t const * const patterns)
 		addr = get_cgram_address(char_n, n + 1);
 		oled_write_cmd(CMD_CGRAM | addr);
 
-		ptn = *(patterns + n);
+		ptn = progmem ? pgm_read_byte(patterns + n) : *(patterns + n);
 		ptn |= (1 << 7) | (1 << 6) | (1 << 5);
 		oled_write_data(ptn);
 	}
 }
 
 
-// Writes an operation (display clear etc.). Checks the busy flag first.
+// Switches between checking the busy flag before each write (default) and timed writes.
+// Timed writes wait for the worst case execution time of the previous instruction,
+// the slow instructions (clear display, cursor home) still check the busy flag.
+void oled_timed_mode(bool enable)
+{
+	g_timed_mode = enable;
+
+	// the previous instruction is unknown.
+	g_wait_ticks = WAIT_BUSY_FLAG;
+}
+
+// Switches writes to the background queue or back to direct writes.
+// The queue is drained by the clock interrupt, interrupts must be enabled.
+void oled_queue_mode(bool enable)
+{
+	if (g_queue_mode && !enable)
+	{
+		oled_flush_wait();
+
+		// the previous instruction is unknown.
+		g_wait_ticks = WAIT_BUSY_FLAG;
+	}
+
+	if (!g_queue_mode && enable)
+	{
+		// the previous instruction is unknown.
+		g_queue_poll = true;
+	}
+
+	g_queue_mode = enable;
+}
+
+// Queues an operation, written in the background.  Written directly when not in queue mode,
+// the clock interrupt only drives the bus in queue mode.
+void oled_queue_cmd(uint8_t command)
+{
+	oled_write_cmd(command);
+}
+
+// Queues data for DDRAM, CGRAM or graphics RAM, written in the background.  Written directly
+// when not in queue mode.
+void oled_queue_data(uint8_t data)
+{
+	oled_write_data(data);
+}
+
+// Waits until every queued write is on the bus.
+void oled_flush_wait(void)
+{
+	while (g_queue_running)
+		;
+}
+
+// Switches the bus clock prescaler with the system clock (see clock.h).
+// The bus clock tick stays the same, so the instruction timing holds.
+void oled_clock(bool fast)
+{
+	oled_hal_clock_scale(fast);
+}
+
+// Writes an operation (display clear etc.). Waits until the display is ready first.
 void oled_write_cmd(uint8_t command)
 {
 	oled_write_cmd_busy(command, true);
 }
 
-// Writes an operation (display clear etc.).  Optionally checks the busy flag first.
+// Writes an operation (display clear etc.).  Optionally waits until the display is ready first.
 void oled_write_cmd_busy(uint8_t command, bool wait_for_bf)
 {
-	if (wait_for_bf)
-		busy_wait();
+	cursor_track(false, command);
 
-	// Set the data bus.
-	set_data_bus(command);
+	if (g_queue_mode)
+	{
+		queue_push(false, command);
+		return;
+	}
 
-	// 0 - command register.
-	OLED_PORT_RS &= ~(1 << OLED_RS);
+	if (wait_for_bf)
+		ready_wait();
 
-	// 0 - write.
-	OLED_PORT_RW &= ~(1 << OLED_RW);
+	bus_write(false, command);
 
-	// Pulse the enable. (on, off)
-	OLED_PORT_EN |= (1 << OLED_EN);
-	OLED_PORT_EN &= ~(1 << OLED_EN);
+	if (g_timed_mode)
+		write_timed(command < CMD_ENTRY_CONTROL ? WAIT_BUSY_FLAG : EXEC_TICKS);
 }
 
 
 // Writes the given data to DDRAM or CGRAM.
 void oled_write_data(uint8_t data)
 {
-	busy_wait();
+	cursor_track(true, data);
 
-	 // Set the data bus.
-	set_data_bus(data);
+	if (g_queue_mode)
+	{
+		queue_push(true, data);
+		return;
+	}
 
-	// 1 - data register.
-	OLED_PORT_RS |= (1 << OLED_RS);
+	ready_wait();
 
-	// 0 - write.
-	OLED_PORT_RW &= ~(1 << OLED_RW);
+	bus_write(true, data);
 
-	 // Pulse the enable. (on, off)
-	OLED_PORT_EN |= (1 << OLED_EN);
-	OLED_PORT_EN &= ~(1 << OLED_EN);
+	if (g_timed_mode)
+		write_timed(EXEC_TICKS);
+}
+
+// Writes n bytes of data to DDRAM, CGRAM or graphics RAM.
+void oled_write_data_n(uint8_t const * data, uint8_t n)
+{
+	write_data_run(data, 1, n);
+}
+
+// Writes the value n times to DDRAM, CGRAM or graphics RAM.
+void oled_fill_data(uint8_t value, uint8_t n)
+{
+	write_data_run(&value, 0, n);
 }
 
 // Set the x and y coordinates for graphics.  Top left is 1,1.
 // note:  the cy co-ordinate is multiple of 8 pixels.
 // eg. cy:1  y=1,
 //     cy:2  y=9.
+// Only the addresses that differ from the display's current address are written.
 void oled_set_coordinates(uint8_t x, uint8_t cy)
 {
 	uint8_t gxa = get_gxa_address(x);
 	uint8_t gya = get_gya_address(cy);
 
-	oled_write_cmd(gxa);
-	oled_write_cmd(gya);
+	if (gxa != g_gxa_cmd)
+		oled_write_cmd(gxa);
+
+	if (gya != g_gya_cmd)
+		oled_write_cmd(gya);
 }
 
 // write pixels at the given x and y co-ordinates.
@@ -262,73 +408,235 @@ void oled_write_pixels_at(uint8_t x, uint8_t cy, uint8_t pixels)
 // Reads the busy flag until the display becomes available for another instruction.
 void busy_wait()
 {
-	// Set data bus bit 7 as input.
-	OLED_DDR_DB7 &= ~(1 << OLED_DB7);
-
 	// 0 - command register.
-	OLED_PORT_RS &= ~(1 << OLED_RS);
+	oled_hal_set_rs(false);
 
-	// 1 - read.
-	OLED_PORT_RW |= (1 << OLED_RW);
+	// 1 - read. (data bus bit 7 as input)
+	oled_hal_set_rw(true);
 
 	// read busy flag until it is 0 (not busy).
-	do
-	{
-		OLED_PORT_EN |= (1 << OLED_EN);
-		OLED_PORT_EN &= ~(1 << OLED_EN);
+	while (oled_hal_read_busy())
+		;
 
-	} while (OLED_PIN_DB7 & (1 << OLED_DB7));
+	// 0 - write. (data bus bit 7 as output)
+	oled_hal_set_rw(false);
+}
 
-	// restore data bus bit 7 as output.
-	OLED_DDR_DB7 |= (1 << OLED_DB7);
+// Reads the busy flag once.
+bool busy_check()
+{
+	oled_hal_set_rs(false);
+	oled_hal_set_rw(true);
 
-	// 0 - write.
-	OLED_PORT_RW &= ~(1 << OLED_RW);
+	bool busy = oled_hal_read_busy();
+
+	oled_hal_set_rw(false);
+
+	return busy;
 }
 
-// Sets the data registers to the given data.
-void set_data_bus(uint8_t data)
+// Waits until the display is ready for another instruction.
+// Timed mode waits for the clock unless the previous instruction was slow.
+void ready_wait()
 {
-	if (data & (1 << 7))
-		OLED_PORT_DB7 |= (1 << OLED_DB7);
+	if (g_timed_mode && g_wait_ticks != WAIT_BUSY_FLAG)
+	{
+		while ((uint8_t)(oled_hal_clock_now() - g_last_write) < g_wait_ticks)
+			;
+	}
 	else
-		OLED_PORT_DB7 &= ~(1 << OLED_DB7);
+	{
+		busy_wait();
+	}
+}
 
-	if (data & (1 << 6))
-		OLED_PORT_DB6 |= (1 << OLED_DB6);
-	else
-		OLED_PORT_DB6 &= ~(1 << OLED_DB6);
+// Records the time of a write in timed mode and the clock ticks to wait before the next.
+void write_timed(uint8_t wait_ticks)
+{
+	g_last_write = oled_hal_clock_now();
+	g_wait_ticks = wait_ticks;
+}
 
-	if (data & (1 << 5))
-		OLED_PORT_DB5 |= (1 << OLED_DB5);
-	else
-		OLED_PORT_DB5 &= ~(1 << OLED_DB5);
+// Keeps the graphics address shadow up to date with a write.
+// Graphics data writes auto increment GXA, GXA and GYA commands set it,
+// anything that may move the address makes it unknown.
+void cursor_track(bool rs, uint8_t data)
+{
+	if (rs)
+	{
+		cursor_advance(1);
+	}
+	else if (g_graphics && (data & CMD_DDRAM))
+	{
+		g_gxa_cmd = data;
+	}
+	else if (g_graphics && (data & CMD_CGRAM))
+	{
+		g_gya_cmd = data;
+	}
+	else if ((data & ~CMD_DISPLAY_CONTROL_MASK) != CMD_DISPLAY_CONTROL)
+	{
+		// everything except display on/off.
+		if ((data & ~(CMD_MODE_GFX | CMD_MODE_POWER)) == (CMD_MODE | CMD_MODE_GFX_FLAG))
+			g_graphics = (data & CMD_MODE_GFX) != 0;
 
-	if (data & (1 << 4))
-		OLED_PORT_DB4 |= (1 << OLED_DB4);
-	else
-		OLED_PORT_DB4 &= ~(1 << OLED_DB4);
+		g_gxa_cmd = 0;
+		g_gya_cmd = 0;
+	}
+}
 
-	if (data & (1 << 3))
-		OLED_PORT_DB3 |= (1 << OLED_DB3);
+// Advances the graphics address shadow by n data writes.
+void cursor_advance(uint8_t n)
+{
+	if (g_graphics && g_gxa_cmd != 0 && (g_gxa_cmd & 0x7F) + n < OLED_PIXEL_COLUMNS)
+	{
+		g_gxa_cmd += n;
+	}
 	else
-		OLED_PORT_DB3 &= ~(1 << OLED_DB3);
+	{
+		g_gxa_cmd = 0;
+		g_gya_cmd = 0;
+	}
+}
 
-	if (data & (1 << 2))
-		OLED_PORT_DB2 |= (1 << OLED_DB2);
-	else
-		OLED_PORT_DB2 &= ~(1 << OLED_DB2);
+// Writes n data bytes, src is advanced by step after each byte (0 repeats a byte).
+// Timed mode sets RS and RW once and only waits on the clock between bytes.
+void write_data_run(uint8_t const * src, uint8_t step, uint8_t n)
+{
+	if (n == 0)
+		return;
 
-	if (data & (1 << 1))
-		OLED_PORT_DB1 |= (1 << OLED_DB1);
-	else
-		OLED_PORT_DB1 &= ~(1 << OLED_DB1);
+	cursor_advance(n);
+
+	if (g_queue_mode)
+	{
+		for (; n != 0; n--, src += step)
+		{
+			queue_push(true, *src);
+		}
 
-	if (data & 1)
-		OLED_PORT_DB0 |= (1 << OLED_DB0);
+		return;
+	}
+
+	if (!g_timed_mode)
+	{
+		for (; n != 0; n--, src += step)
+		{
+			busy_wait();
+			bus_write(true, *src);
+		}
+
+		return;
+	}
+
+	ready_wait();
+
+	// 1 - data register, 0 - write.
+	oled_hal_set_rs(true);
+	oled_hal_set_rw(false);
+
+	while (1)
+	{
+		oled_hal_set_data(*src);
+		oled_hal_pulse_en();
+
+		uint8_t written = oled_hal_clock_now();
+
+		if (--n == 0)
+		{
+			g_last_write = written;
+			g_wait_ticks = EXEC_TICKS;
+			return;
+		}
+
+		src += step;
+
+		while ((uint8_t)(oled_hal_clock_now() - written) < EXEC_TICKS)
+			;
+	}
+}
+
+// Adds a write to the queue, waits while the queue is full.
+void queue_push(bool rs, uint8_t data)
+{
+	uint8_t head = g_queue_head;
+	uint8_t next = (head + 1) & QUEUE_MASK;
+
+	while (next == g_queue_tail)
+		;
+
+	uint8_t bit = 1 << (head & 7);
+
+	g_queue_data[head] = data;
+
+	if (rs)
+		g_queue_rs[head >> 3] |= bit;
 	else
-		OLED_PORT_DB0 &= ~(1 << OLED_DB0);
- }
+		g_queue_rs[head >> 3] &= ~bit;
+
+	// publish the entry before checking the interrupt is running.
+	g_queue_head = next;
+
+	if (!g_queue_running)
+	{
+		// the queue is drained at the fast clock.
+		g_queue_running = true;
+		clock_fast();
+		oled_hal_schedule(QUEUE_MIN_TICKS);
+	}
+}
+
+// Clock interrupt, writes the next queued entry and schedules the one after.
+void oled_hal_scheduled(void)
+{
+	uint8_t tail = g_queue_tail;
+
+	if (tail == g_queue_head)
+	{
+		oled_hal_schedule_stop();
+		g_queue_running = false;
+		clock_slow();
+		return;
+	}
+
+	if (g_queue_poll)
+	{
+		if (busy_check())
+		{
+			oled_hal_schedule(QUEUE_POLL_TICKS);
+			return;
+		}
+
+		g_queue_poll = false;
+	}
+
+	uint8_t data = g_queue_data[tail];
+	bool rs = (g_queue_rs[tail >> 3] & (1 << (tail & 7))) != 0;
+
+	bus_write(rs, data);
+	g_queue_tail = (tail + 1) & QUEUE_MASK;
+
+	// slow instructions are followed by busy flag checks.
+	g_queue_poll = !rs && data < CMD_ENTRY_CONTROL;
+
+	oled_hal_schedule(g_queue_poll ? QUEUE_POLL_TICKS : EXEC_TICKS);
+}
+
+// Writes a command (rs false) or data (rs true) to the bus.
+static inline void bus_write(bool rs, uint8_t data)
+{
+	// Set the data bus.
+	oled_hal_set_data(data);
+
+	// 0 - command register, 1 - data register.
+	oled_hal_set_rs(rs);
+
+	// 0 - write.
+	oled_hal_set_rw(false);
+
+	// Pulse the enable. (on, off)
+	oled_hal_pulse_en();
+}
 
 // gets the address for the given column and row.
 // displays using case N1. (see comments at top).
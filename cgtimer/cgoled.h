@@ -65,6 +65,9 @@
 #define OLED_PIXEL_ROWS    16
 #define OLED_BYTE_ROWS (OLED_PIXEL_ROWS / 8)
 
+// characters on each row in character mode, each is 5 pixel columns and a space.
+#define OLED_CHARACTER_COLUMNS (OLED_PIXEL_COLUMNS / 6)
+
 // Command bits used to control the OLED.
 // Used as arguments when calling oled_write_cmd().
 //
@@ -133,6 +136,9 @@ void oled_incremental_cursor();
 // switch to graphics mode.
 void oled_graphics_mode();
 
+// switch to character mode, the DDRAM characters are shown instead of the graphics RAM.
+void oled_character_mode();
+
 // switch the OLED on.
 void oled_power_on();
 
@@ -142,22 +148,58 @@ void oled_power_off();
 // write character at given position.
 void oled_write_character(uint8_t character, uint8_t column, uint8_t row);
 
+// write n characters from the given position, the address is written once for the run.
+void oled_write_characters(uint8_t const * characters, uint8_t n, uint8_t column, uint8_t row);
+
 // sets a user defined character in the displays CGRAM.
 // 8 user definable characters (char_n 1 to 8).
 // characters are 5x8 (7 + cursor row).
 // patterns pointer must point to 8 uint8_t rows.
 void oled_set_character(uint8_t char_n, uint8_t const * const patterns);
 
+// sets a user defined character from patterns held in program memory (PROGMEM).
+void oled_set_character_P(uint8_t char_n, uint8_t const * const patterns);
+
+
+// Switches between checking the busy flag before each write (default) and timed writes.
+// Timed writes wait for the worst case execution time of the previous instruction,
+// the slow instructions (clear display, cursor home) still check the busy flag.
+void oled_timed_mode(bool enable);
+
+// Switches writes to the background queue or back to direct writes.
+// In queue mode oled_write_cmd() and oled_write_data() add to the queue, which is drained by
+// an interrupt paced by the instruction execution times.  Interrupts must be enabled.
+void oled_queue_mode(bool enable);
 
-// Writes an operation (display clear etc.). Checks the busy flag first.
+// Queues an operation, written in the background.  Written directly when not in queue mode.
+void oled_queue_cmd(uint8_t command);
+
+// Queues data for DDRAM, CGRAM or graphics RAM, written in the background.  Written directly
+// when not in queue mode.
+void oled_queue_data(uint8_t data);
+
+// Waits until every queued write is on the bus.
+void oled_flush_wait(void);
+
+// Switches the bus clock prescaler with the system clock (see clock.h).
+void oled_clock(bool fast);
+
+// Writes an operation (display clear etc.). Waits until the display is ready first.
 void oled_write_cmd(uint8_t command);
 
-// Writes an operation (display clear etc.).  Optionally checks the busy flag first.
+// Writes an operation (display clear etc.).  Optionally waits until the display is ready first.
 void oled_write_cmd_busy(uint8_t command, bool wait_for_bf);
 
 // Writes the given data to DDRAM or CGRAM.
 void oled_write_data(uint8_t data);
 
+// Writes n bytes of data to DDRAM, CGRAM or graphics RAM.
+// RS and RW are set once for the whole run.
+void oled_write_data_n(uint8_t const * data, uint8_t n);
+
+// Writes the value n times to DDRAM, CGRAM or graphics RAM.
+void oled_fill_data(uint8_t value, uint8_t n);
+
 // Set the x and y coordinates for graphics.  Top left is 1,1.
 // note:  the cy co-ordinate is multiple of 8 pixels.
 // eg. cy:1  y=1, 
@@ -0,0 +1,64 @@
+/*
+ * clock.c
+ *
+ */ 
+
+#include "clock.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/power.h>
+#include "tick.h"
+#include "timebase.h"
+#include "cgoled.h"
+
+// requests for the fast clock, from the main loop and the display queue interrupt.
+static uint8_t g_fast_requests = 0;
+
+// function declarations.
+void clock_set(bool fast);
+
+
+// sets the idle clock.
+void clock_config(void)
+{
+	clock_set(false);
+}
+
+// asks for the fast clock, each call is matched by a call to clock_slow().
+void clock_fast(void)
+{
+	uint8_t sreg = SREG;
+	cli();
+
+	if (g_fast_requests++ == 0)
+		clock_set(true);
+
+	SREG = sreg;
+}
+
+// drops a request for the fast clock, the clock slows when there are none left.
+void clock_slow(void)
+{
+	uint8_t sreg = SREG;
+	cli();
+
+	if (g_fast_requests != 0 && --g_fast_requests == 0)
+		clock_set(false);
+
+	SREG = sreg;
+}
+
+// switches the clock prescaler and the timer prescalers together.
+// called with interrupts held off (clock_config runs before they are enabled).
+void clock_set(bool fast)
+{
+#ifdef CLOCK_SCALING
+	clock_prescale_set(fast ? clock_div_1 : clock_div_8);
+
+	tick_clock(fast);
+	timebase_clock(fast);
+	oled_clock(fast);
+#else
+	(void)fast;
+#endif
+}
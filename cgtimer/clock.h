@@ -0,0 +1,45 @@
+/*
+ * clock.h
+ *
+ * System clock governor.
+ *
+ * The MCU runs from the internal 8 MHz RC oscillator through the clock prescaler, divided
+ * by 8 (F_CPU 1 MHz) while idle. Animation and display writes ask for the full 8 MHz and the
+ * clock drops back once nothing needs it.
+ *
+ * The timers count at the same rate at either clock, their prescalers are switched with the
+ * clock (tick_clock, timebase_clock and oled_clock), so timekeeping and the display bus timing
+ * hold at both. A switch can move the timers by up to one of their counts (8 us).
+ *
+ * Scaling needs the 1 MHz build (the CKDIV8 fuse), at any other F_CPU the clock is left alone.
+ *
+ */ 
+
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#ifndef F_CPU				// if F_CPU was not defined in Project -> Properties
+#define F_CPU 1000000UL		// define it now as 1 MHz unsigned long
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// the fast clock, the oscillator undivided.
+#define CLOCK_FAST_HZ 8000000UL
+
+#if F_CPU == 1000000UL
+#define CLOCK_SCALING
+#endif
+
+// sets the idle clock.
+void clock_config(void);
+
+// asks for the fast clock, each call is matched by a call to clock_slow().
+void clock_fast(void);
+
+// drops a request for the fast clock, the clock slows when there are none left.
+void clock_slow(void);
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,39 @@
+/*
+ * font5x8.h
+ *
+ * 5x8 (5 columns) font atlas covering the printable ASCII characters (space to ~).
+ * Each glyph is 5 bytes, one byte per pixel column, least significant bit is top.
+ * The atlas is held in program memory, use the _P functions to draw the glyphs.
+ *
+ */ 
+
+
+#ifndef FONT5X8_H_
+#define FONT5X8_H_
+
+#include <stdint.h>
+
+#define FONT5X8_COLUMNS 5
+// glyph columns plus one blank column between glyphs.
+#define FONT5X8_ADVANCE (FONT5X8_COLUMNS + 1)
+
+#define FONT5X8_FIRST ' '
+#define FONT5X8_LAST  '~'
+
+// digit glyphs, shared by the atlas and the pre-shifted digit tables (see numeric5x8.h).
+#define FONT5X8_DIGIT_0 0x3E, 0x51, 0x49, 0x45, 0x3E
+#define FONT5X8_DIGIT_1 0x00, 0x42, 0x7F, 0x40, 0x00
+#define FONT5X8_DIGIT_2 0x42, 0x61, 0x51, 0x49, 0x46
+#define FONT5X8_DIGIT_3 0x21, 0x41, 0x45, 0x4B, 0x31
+#define FONT5X8_DIGIT_4 0x18, 0x14, 0x12, 0x7F, 0x10
+#define FONT5X8_DIGIT_5 0x27, 0x45, 0x45, 0x45, 0x39
+#define FONT5X8_DIGIT_6 0x3C, 0x4A, 0x49, 0x49, 0x30
+#define FONT5X8_DIGIT_7 0x01, 0x01, 0x71, 0x0D, 0x03
+#define FONT5X8_DIGIT_8 0x36, 0x49, 0x49, 0x49, 0x36
+#define FONT5X8_DIGIT_9 0x06, 0x49, 0x49, 0x29, 0x1E
+
+// returns pointer to the glyph of the character (program memory).
+// characters outside the atlas are shown as '?'.
+uint8_t const * font5x8_ptr(char c);
+
+#endif /* FONT5X8_H_ */
@@ -8,11 +8,21 @@
 
 #include "gfx.h"
 #include "cgoled.h"
+#include "font5x8.h"
+#include <stdbool.h>
+#include <avr/pgmspace.h>
 
 #define MAX_ROWS 2
 
+// shifted image columns written per burst.
+#define CHUNK_COLUMNS 16
+
 // function declarations.
 void set_cy_shiftn(uint8_t y, uint8_t * cy, uint8_t * shift_n);
+void image_at(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns, bool progmem);
+void write_shifted(uint8_t const * image, uint8_t columns, uint8_t shift_n, bool down, bool progmem);
+void text_at(uint8_t x, uint8_t y, char const * text, bool progmem);
+void write_text(char const * text, uint8_t columns, uint8_t shift_n, bool down, bool progmem);
 
 
 // displays a single column of 8 pixel rows at the given pixel co-ordinates.
@@ -42,6 +52,21 @@ void gfx_pixels_at(uint8_t x, uint8_t y, uint8_t pixels)
  // the image is a dynamic number of pixel columns (parameter columns).
  // the image is 8 rows of pixels.
 void gfx_image_at(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns)
+{
+	image_at(x, y, image, columns, false);
+}
+
+ // displays an image held in program memory at the given pixel co-ordinates (parameters x, y).
+ // the image is a dynamic number of pixel columns (parameter columns).
+ // the image is 8 rows of pixels.
+void gfx_image_at_P(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns)
+{
+	image_at(x, y, image, columns, true);
+}
+
+
+// displays an image from data memory or program memory (progmem).
+void image_at(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns, bool progmem)
 {
 	// Note: due to the way the display works, the image may span two rows.
 	uint8_t cy = 1;
@@ -50,32 +75,119 @@ void gfx_image_at(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t col
 	set_cy_shiftn(y, &cy, &shift_n);
 	oled_set_coordinates(x, cy);
 
-	if (shift_n == 0)
+	if (shift_n == 0 && !progmem)
 	{
-		for (uint8_t n = 0; n != columns; n++)
-		{
-			oled_write_data(*(image + n));
-		}
+		oled_write_data_n(image, columns);
 	}
 	else
 	{
-		for (uint8_t n = 0; n != columns; n++)
-		{
-			oled_write_data((*(image + n)) << shift_n);
-		}
+		write_shifted(image, columns, shift_n, true, progmem);
 		
-		if (cy < MAX_ROWS)
+		if (shift_n != 0 && cy < MAX_ROWS)
 		{
 			cy++;
 			oled_set_coordinates(x, cy);
 
-			shift_n = 8 - shift_n;
-			for (uint8_t n = 0; n != columns; n++)
+			write_shifted(image, columns, 8 - shift_n, false, progmem);
+		}
+	}
+}
+
+// writes the image columns shifted down (towards the next row) or up, in bursts.
+// images in program memory (progmem) are read through pgm_read_byte.
+void write_shifted(uint8_t const * image, uint8_t columns, uint8_t shift_n, bool down, bool progmem)
+{
+	uint8_t chunk[CHUNK_COLUMNS];
+
+	while (columns != 0)
+	{
+		uint8_t n = columns < CHUNK_COLUMNS ? columns : CHUNK_COLUMNS;
+
+		for (uint8_t i = 0; i != n; i++)
+		{
+			uint8_t pixels = progmem ? pgm_read_byte(&image[i]) : image[i];
+			chunk[i] = down ? pixels << shift_n : pixels >> shift_n;
+		}
+
+		oled_write_data_n(&chunk[0], n);
+
+		image += n;
+		columns -= n;
+	}
+}
+
+ // displays the text at the given pixel co-ordinates (parameters x, y).
+ // the text is 8 rows of pixels, characters are FONT5X8_ADVANCE columns apart.
+void gfx_text_at(uint8_t x, uint8_t y, char const * text)
+{
+	text_at(x, y, text, false);
+}
+
+ // displays text held in program memory at the given pixel co-ordinates (parameters x, y).
+void gfx_text_at_P(uint8_t x, uint8_t y, char const * text)
+{
+	text_at(x, y, text, true);
+}
+
+
+// displays text from data memory or program memory (progmem).
+// each row the text covers is a single coordinate set followed by the data run.
+void text_at(uint8_t x, uint8_t y, char const * text, bool progmem)
+{
+	if (x < 1 || x > OLED_PIXEL_COLUMNS)
+		return;
+
+	// columns available up to the right edge of the display.
+	uint8_t columns = OLED_PIXEL_COLUMNS - x + 1;
+	uint8_t cy = 1;
+	uint8_t shift_n = 0;
+
+	set_cy_shiftn(y, &cy, &shift_n);
+	oled_set_coordinates(x, cy);
+
+	write_text(text, columns, shift_n, true, progmem);
+
+	if (shift_n != 0 && cy < MAX_ROWS)
+	{
+		cy++;
+		oled_set_coordinates(x, cy);
+
+		write_text(text, columns, 8 - shift_n, false, progmem);
+	}
+}
+
+// writes the glyph columns of the text shifted down (towards the next row) or up, in bursts.
+// a blank column is written between characters, the text is cut at the given number of columns.
+void write_text(char const * text, uint8_t columns, uint8_t shift_n, bool down, bool progmem)
+{
+	uint8_t chunk[CHUNK_COLUMNS];
+	uint8_t n = 0;
+	char c = progmem ? pgm_read_byte(text) : *text;
+
+	while (c != '\0' && columns != 0)
+	{
+		uint8_t const * glyph = font5x8_ptr(c);
+
+		text++;
+		c = progmem ? pgm_read_byte(text) : *text;
+
+		uint8_t glyph_columns = c != '\0' ? FONT5X8_ADVANCE : FONT5X8_COLUMNS;
+
+		for (uint8_t i = 0; i != glyph_columns && columns != 0; i++, columns--)
+		{
+			uint8_t pixels = i < FONT5X8_COLUMNS ? pgm_read_byte(&glyph[i]) : 0x00;
+			chunk[n++] = down ? pixels << shift_n : pixels >> shift_n;
+
+			if (n == CHUNK_COLUMNS)
 			{
-				oled_write_data((*(image + n)) >> shift_n);
-			}			
+				oled_write_data_n(&chunk[0], n);
+				n = 0;
+			}
 		}
 	}
+
+	if (n != 0)
+		oled_write_data_n(&chunk[0], n);
 }
 
 
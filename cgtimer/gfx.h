@@ -35,4 +35,14 @@ void gfx_pixels_at(uint8_t x, uint8_t y, uint8_t pixels);
  // the image is 8 rows of pixels.
 void gfx_image_at(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns);
 
+ // displays an image held in program memory (PROGMEM) at the given pixel co-ordinates.
+void gfx_image_at_P(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns);
+
+ // displays the text at the given pixel co-ordinates using the 5x8 font (see font5x8.h).
+ // each 8 pixel row the text covers is written as one run, the text is cut at the right edge.
+void gfx_text_at(uint8_t x, uint8_t y, char const * text);
+
+ // displays text held in program memory (PROGMEM) at the given pixel co-ordinates.
+void gfx_text_at_P(uint8_t x, uint8_t y, char const * text);
+
 #endif /* GFX_H_ */
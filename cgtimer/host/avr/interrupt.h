@@ -0,0 +1,19 @@
+/*
+ * avr/interrupt.h (host shim)
+ *
+ * Interrupt service routines become plain functions the host can call,
+ * eg. TIMER1_COMPA_vect() simulates a timer1 compare match.
+ *
+ */ 
+
+#include <avr/io.h>
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#define ISR(vector) void vector(void)
+
+#define sei()
+#define cli()
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
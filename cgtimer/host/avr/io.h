@@ -0,0 +1,80 @@
+/*
+ * avr/io.h (host shim)
+ *
+ * The ATmega328P registers used by cgtimer, as plain variables (see avr_io.c).
+ * Lets the sources that touch registers compile on a developer machine.
+ *
+ */ 
+
+#include <stdint.h>
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+// ports.
+extern volatile uint8_t DDRB, PORTB, PINB;
+extern volatile uint8_t DDRC, PORTC, PINC;
+extern volatile uint8_t DDRD, PORTD, PIND;
+
+// status register.
+extern volatile uint8_t SREG;
+
+// pin change interrupts.
+extern volatile uint8_t PCICR, PCIFR, PCMSK1;
+
+// power reduction, analog comparator and clock prescaler.
+extern volatile uint8_t PRR, ACSR, CLKPR;
+
+// timer0.
+extern volatile uint8_t TCCR0A, TCCR0B, OCR0A, TIMSK0, TCNT0;
+
+// timer1.
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+extern volatile uint16_t OCR1A, TCNT1;
+
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+#define PRADC 0
+#define PRUSART0 1
+#define PRSPI 2
+#define PRTWI 7
+#define ACD 7
+
+#define PCIE1 1
+#define PCIF1 1
+
+#define CS00 0
+#define CS01 1
+#define CS02 2
+#define WGM01 1
+#define OCIE0A 1
+
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define WGM12 3
+#define OCIE1A 1
+#define OCF1A 1
+
+#endif /* HOST_AVR_IO_H_ */
@@ -0,0 +1,19 @@
+/*
+ * avr/pgmspace.h (host shim)
+ *
+ * Program memory is ordinary memory on the host.
+ *
+ */ 
+
+#include <stdint.h>
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#define PROGMEM
+
+#define pgm_read_byte(addr) (*(uint8_t const *)(addr))
+#define pgm_read_word(addr) (*(uint16_t const *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
@@ -0,0 +1,23 @@
+/*
+ * avr/power.h (host shim)
+ *
+ * The clock prescaler is a register variable on the host (see avr_io.c).
+ *
+ */ 
+
+#ifndef HOST_AVR_POWER_H_
+#define HOST_AVR_POWER_H_
+
+#include <avr/io.h>
+
+typedef enum
+{
+	clock_div_1 = 0,
+	clock_div_2 = 1,
+	clock_div_4 = 2,
+	clock_div_8 = 3
+}clock_div_t;
+
+#define clock_prescale_set(x) (CLKPR = (x))
+
+#endif /* HOST_AVR_POWER_H_ */
@@ -0,0 +1,20 @@
+/*
+ * avr/sleep.h (host shim)
+ *
+ * Sleeping returns immediately on the host.
+ *
+ */ 
+
+#ifndef HOST_AVR_SLEEP_H_
+#define HOST_AVR_SLEEP_H_
+
+#define SLEEP_MODE_IDLE 0
+#define SLEEP_MODE_PWR_DOWN 2
+
+#define set_sleep_mode(mode)
+#define sleep_enable()
+#define sleep_disable()
+#define sleep_cpu()
+#define sleep_mode()
+
+#endif /* HOST_AVR_SLEEP_H_ */
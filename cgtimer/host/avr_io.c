@@ -0,0 +1,29 @@
+/*
+ * avr_io.c (host shim)
+ *
+ * Storage for the registers declared in avr/io.h.
+ *
+ */ 
+
+#include <avr/io.h>
+
+// ports.
+volatile uint8_t DDRB, PORTB, PINB;
+volatile uint8_t DDRC, PORTC, PINC;
+volatile uint8_t DDRD, PORTD, PIND;
+
+// status register.
+volatile uint8_t SREG;
+
+// pin change interrupts.
+volatile uint8_t PCICR, PCIFR, PCMSK1;
+
+// power reduction, analog comparator and clock prescaler.
+volatile uint8_t PRR, ACSR, CLKPR;
+
+// timer0.
+volatile uint8_t TCCR0A, TCCR0B, OCR0A, TIMSK0, TCNT0;
+
+// timer1.
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+volatile uint16_t OCR1A, TCNT1;
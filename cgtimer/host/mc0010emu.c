@@ -0,0 +1,391 @@
+/*
+ * mc0010emu.c
+ *
+ * Software emulator of the MC0010 controller for host builds.
+ *
+ */ 
+
+#include "mc0010emu.h"
+#include <string.h>
+#include <avr/pgmspace.h>
+#include "../font5x8.h"
+
+// command bits (see cgoled.h and cgoled.c).
+#define CMD_CLEAR_DISPLAY 0x01
+#define CMD_CURSOR_HOME 0x02
+#define CMD_ENTRY_CONTROL 0x04
+#define CMD_ENTRY_INCREMENT 0x02
+#define CMD_ENTRY_SHIFT_DISPLAY 0x01
+#define CMD_DISPLAY_CONTROL 0x08
+#define CMD_DISPLAY_POWER 0x04
+#define CMD_SHIFT_CONTROL 0x10
+#define CMD_SHIFT_DISPLAY 0x08
+#define CMD_SHIFT_RIGHT 0x04
+#define CMD_MODE_GFX 0x08
+#define CMD_MODE_POWER 0x04
+#define CMD_MODE_FLAG 0x03
+#define CMD_FUNC_CONTROL 0x20
+#define CMD_CGRAM 0x40
+#define CMD_DDRAM 0x80
+
+// ddram line 2 address (displays using case N1).
+#define DDRAM_LINE2 0x40
+
+// character width in pixels and the cells, a character and a space.
+#define CHAR_COLUMNS 5
+#define CHAR_PITCH 6
+
+// controller state.
+typedef struct
+{
+	uint8_t gram[MC0010_GRAM_PAGES][MC0010_GRAM_COLUMNS];
+	uint8_t ddram[MC0010_DDRAM_SIZE];
+	uint8_t cgram[MC0010_CGRAM_SIZE];
+
+	// graphics address.
+	uint8_t gxa;
+	uint8_t gya;
+
+	// character address counter, selects ddram or cgram.
+	uint8_t ac;
+	bool ac_cgram;
+
+	// entry mode.
+	bool increment;
+	bool shift_display;
+
+	// display shift in characters.
+	int8_t shift;
+
+	bool graphics;
+	bool display_on;
+
+	uint64_t busy_until_ns;
+
+}mc0010_t;
+
+static mc0010_t g_emu;
+static mc0010_cost_t g_cost;
+static mc0010_stats_t g_stats;
+static uint64_t g_now_ns = 0;
+
+// function declarations.
+void emu_op(oled_hal_op_t op);
+void emu_write(bool rs, uint8_t data);
+bool emu_read_busy(void);
+uint64_t emu_clock_ns(void);
+void emu_command(uint8_t command);
+void emu_data(uint8_t data);
+void emu_move_ac(bool right);
+uint64_t cycles_ns(uint16_t cycles);
+
+static const oled_hal_device_t g_device = { emu_op, emu_write, emu_read_busy, emu_clock_ns };
+
+
+// returns the default cost model (1 MHz MCU).
+// execution times are the worst case of the MC0010 instruction table,
+// the clear display and cursor home instructions are slow.
+mc0010_cost_t mc0010_default_cost(void)
+{
+	mc0010_cost_t cost;
+
+	cost.mcu_hz = 1000000UL;
+
+	// port instructions, plus the loop around busy flag and clock reads.
+	cost.op_cycles[OLED_HAL_SET_DATA] = 2;
+	cost.op_cycles[OLED_HAL_SET_RS] = 2;
+	cost.op_cycles[OLED_HAL_SET_RW] = 4;
+	cost.op_cycles[OLED_HAL_PULSE_EN] = 4;
+	cost.op_cycles[OLED_HAL_READ_BUSY] = 7;
+	cost.op_cycles[OLED_HAL_CLOCK_READ] = 5;
+
+	cost.exec_ns[MC0010_CLEAR_DISPLAY] = 6200000UL;
+	cost.exec_ns[MC0010_CURSOR_HOME] = 6200000UL;
+	cost.exec_ns[MC0010_ENTRY_CONTROL] = 40000UL;
+	cost.exec_ns[MC0010_DISPLAY_CONTROL] = 40000UL;
+	cost.exec_ns[MC0010_SHIFT_CONTROL] = 40000UL;
+	cost.exec_ns[MC0010_MODE_POWER] = 40000UL;
+	cost.exec_ns[MC0010_FUNC_CONTROL] = 40000UL;
+	cost.exec_ns[MC0010_CGRAM_GYA] = 40000UL;
+	cost.exec_ns[MC0010_DDRAM_GXA] = 40000UL;
+	cost.exec_ns[MC0010_WRITE_DATA] = 40000UL;
+
+	return cost;
+}
+
+// resets the controller and attaches it to the bus.
+void mc0010_init(mc0010_cost_t const * cost)
+{
+	g_cost = *cost;
+
+	memset(&g_emu, 0, sizeof(g_emu));
+	memset(g_emu.ddram, ' ', sizeof(g_emu.ddram));
+	g_emu.increment = true;
+
+	mc0010_stats_reset();
+	g_now_ns = 0;
+
+	oled_hal_attach(&g_device);
+}
+
+// returns the emulated time in ns.
+uint64_t mc0010_now_ns(void)
+{
+	return g_now_ns;
+}
+
+// advances the emulated time (MCU work outside the bus).
+void mc0010_advance_ns(uint32_t ns)
+{
+	g_now_ns += ns;
+}
+
+// returns the counters.
+mc0010_stats_t mc0010_stats(void)
+{
+	return g_stats;
+}
+
+// resets the counters.
+void mc0010_stats_reset(void)
+{
+	memset(&g_stats, 0, sizeof(g_stats));
+}
+
+// returns true when the pixel is on.  x and y are 1 based (top left 1,1).
+bool mc0010_pixel(uint8_t x, uint8_t y)
+{
+	if (!g_emu.display_on || x < 1 || y < 1 || y > MC0010_GRAM_PAGES * 8)
+		return false;
+
+	x--;
+	y--;
+
+	if (g_emu.graphics)
+	{
+		if (x >= MC0010_GRAM_COLUMNS)
+			return false;
+
+		return (g_emu.gram[y / 8][x] >> (y % 8)) & 1;
+	}
+
+	// character mode, the user defined characters (CGRAM) and the font atlas standing in
+	// for the character ROM.
+	int16_t cell = x / CHAR_PITCH + g_emu.shift;
+	uint8_t addr = (uint8_t)((y / 8) * DDRAM_LINE2 + (cell & 0x3F));
+	uint8_t code = g_emu.ddram[addr & 0x7F];
+	uint8_t column = x % CHAR_PITCH;
+
+	if (column >= CHAR_COLUMNS)
+		return false;
+
+	if (code >= 0x10)
+		return (pgm_read_byte(font5x8_ptr((char)code) + column) >> (y % 8)) & 1;
+
+	uint8_t pattern = g_emu.cgram[((code & 0x07) << 3) | (y % 8)];
+	return (pattern >> (CHAR_COLUMNS - 1 - column)) & 1;
+}
+
+// returns the graphics RAM byte.  x and cy are 1 based.
+uint8_t mc0010_gram(uint8_t x, uint8_t cy)
+{
+	if (x < 1 || x > MC0010_GRAM_COLUMNS || cy < 1 || cy > MC0010_GRAM_PAGES)
+		return 0;
+
+	return g_emu.gram[cy - 1][x - 1];
+}
+
+// returns the DDRAM byte at the address.
+uint8_t mc0010_ddram(uint8_t addr)
+{
+	return g_emu.ddram[addr & 0x7F];
+}
+
+// returns true in graphics mode.
+bool mc0010_graphics_mode(void)
+{
+	return g_emu.graphics;
+}
+
+// prints the visible display (columns x rows) as text, '#' on and '.' off.
+void mc0010_print(FILE * f, uint8_t columns, uint8_t rows)
+{
+	for (uint8_t y = 1; y <= rows; y++)
+	{
+		for (uint8_t x = 1; x <= columns; x++)
+		{
+			fputc(mc0010_pixel(x, y) ? '#' : '.', f);
+		}
+
+		fputc('\n', f);
+	}
+}
+
+
+// a bus primitive.
+void emu_op(oled_hal_op_t op)
+{
+	g_now_ns += cycles_ns(g_cost.op_cycles[op]);
+}
+
+// a write latched by the enable pulse.
+void emu_write(bool rs, uint8_t data)
+{
+	if (g_now_ns < g_emu.busy_until_ns)
+		g_stats.busy_violations++;
+
+	if (rs)
+		emu_data(data);
+	else
+		emu_command(data);
+}
+
+// a busy flag read.
+bool emu_read_busy(void)
+{
+	return g_now_ns < g_emu.busy_until_ns;
+}
+
+// a clock read.
+uint64_t emu_clock_ns(void)
+{
+	return g_now_ns;
+}
+
+// executes an instruction.
+void emu_command(uint8_t command)
+{
+	mc0010_instruction_t instruction;
+
+	if (command & CMD_DDRAM)
+	{
+		instruction = MC0010_DDRAM_GXA;
+
+		if (g_emu.graphics)
+		{
+			g_emu.gxa = command & 0x7F;
+		}
+		else
+		{
+			g_emu.ac = command & 0x7F;
+			g_emu.ac_cgram = false;
+		}
+	}
+	else if (command & CMD_CGRAM)
+	{
+		instruction = MC0010_CGRAM_GYA;
+
+		if (g_emu.graphics)
+		{
+			g_emu.gya = command & 0x01;
+		}
+		else
+		{
+			g_emu.ac = command & 0x3F;
+			g_emu.ac_cgram = true;
+		}
+	}
+	else if (command & CMD_FUNC_CONTROL)
+	{
+		instruction = MC0010_FUNC_CONTROL;
+	}
+	else if (command & CMD_SHIFT_CONTROL)
+	{
+		if ((command & CMD_MODE_FLAG) == CMD_MODE_FLAG)
+		{
+			instruction = MC0010_MODE_POWER;
+			g_emu.graphics = (command & CMD_MODE_GFX) != 0;
+		}
+		else
+		{
+			instruction = MC0010_SHIFT_CONTROL;
+
+			if (command & CMD_SHIFT_DISPLAY)
+				g_emu.shift += (command & CMD_SHIFT_RIGHT) ? -1 : 1;
+			else
+				emu_move_ac(command & CMD_SHIFT_RIGHT);
+		}
+	}
+	else if (command & CMD_DISPLAY_CONTROL)
+	{
+		instruction = MC0010_DISPLAY_CONTROL;
+		g_emu.display_on = (command & CMD_DISPLAY_POWER) != 0;
+	}
+	else if (command & CMD_ENTRY_CONTROL)
+	{
+		instruction = MC0010_ENTRY_CONTROL;
+		g_emu.increment = (command & CMD_ENTRY_INCREMENT) != 0;
+		g_emu.shift_display = (command & CMD_ENTRY_SHIFT_DISPLAY) != 0;
+	}
+	else if (command & CMD_CURSOR_HOME)
+	{
+		instruction = MC0010_CURSOR_HOME;
+		g_emu.ac = 0;
+		g_emu.ac_cgram = false;
+		g_emu.shift = 0;
+	}
+	else if (command & CMD_CLEAR_DISPLAY)
+	{
+		instruction = MC0010_CLEAR_DISPLAY;
+		memset(g_emu.ddram, ' ', sizeof(g_emu.ddram));
+		memset(g_emu.gram, 0, sizeof(g_emu.gram));
+		g_emu.ac = 0;
+		g_emu.ac_cgram = false;
+		g_emu.gxa = 0;
+		g_emu.gya = 0;
+		g_emu.shift = 0;
+		g_emu.increment = true;
+	}
+	else
+	{
+		// no operation.
+		return;
+	}
+
+	g_stats.instructions[instruction]++;
+	g_emu.busy_until_ns = g_now_ns + g_cost.exec_ns[instruction];
+}
+
+// writes data to graphics RAM, DDRAM or CGRAM.
+void emu_data(uint8_t data)
+{
+	if (g_emu.graphics)
+	{
+		g_emu.gram[g_emu.gya][g_emu.gxa] = data;
+
+		// auto increment, wrapping to the start of the other page.
+		if (++g_emu.gxa == MC0010_GRAM_COLUMNS)
+		{
+			g_emu.gxa = 0;
+			g_emu.gya ^= 1;
+		}
+	}
+	else
+	{
+		if (g_emu.ac_cgram)
+			g_emu.cgram[g_emu.ac & 0x3F] = data & 0x1F;
+		else
+			g_emu.ddram[g_emu.ac & 0x7F] = data;
+
+		emu_move_ac(g_emu.increment);
+
+		if (g_emu.shift_display)
+			g_emu.shift += g_emu.increment ? 1 : -1;
+	}
+
+	g_stats.instructions[MC0010_WRITE_DATA]++;
+	g_emu.busy_until_ns = g_now_ns + g_cost.exec_ns[MC0010_WRITE_DATA];
+}
+
+// moves the character address counter.
+void emu_move_ac(bool right)
+{
+	uint8_t mask = g_emu.ac_cgram ? 0x3F : 0x7F;
+	g_emu.ac = (g_emu.ac + (right ? 1 : -1)) & mask;
+}
+
+// converts MCU cycles to ns.
+uint64_t cycles_ns(uint16_t cycles)
+{
+	return (uint64_t)cycles * 1000000000ULL / g_cost.mcu_hz;
+}
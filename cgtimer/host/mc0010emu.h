@@ -0,0 +1,104 @@
+/*
+ * mc0010emu.h
+ *
+ * Software emulator of the MC0010 controller for host builds.
+ *
+ * Attaches to the Linux bus backend (oledhal_linux.c) and models the graphics RAM
+ * (GXA/GYA addressing with auto increment), DDRAM, CGRAM, the clear/home/entry/shift
+ * commands and the busy flag.
+ *
+ * Time is advanced by a cost model: every bus primitive costs MCU cycles and every
+ * instruction keeps the busy flag set for its execution time.  Both are configurable.
+ *
+ */ 
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "oledhal_linux.h"
+
+#ifndef MC0010EMU_H_
+#define MC0010EMU_H_
+
+// graphics RAM (largest supported display, 100 x 16).
+#define MC0010_GRAM_COLUMNS 100
+#define MC0010_GRAM_PAGES 2
+
+#define MC0010_DDRAM_SIZE 128
+#define MC0010_CGRAM_SIZE 64
+
+// instruction kinds, indexes the execution times.
+typedef enum
+{
+	MC0010_CLEAR_DISPLAY,
+	MC0010_CURSOR_HOME,
+	MC0010_ENTRY_CONTROL,
+	MC0010_DISPLAY_CONTROL,
+	MC0010_SHIFT_CONTROL,
+	MC0010_MODE_POWER,
+	MC0010_FUNC_CONTROL,
+	MC0010_CGRAM_GYA,
+	MC0010_DDRAM_GXA,
+	MC0010_WRITE_DATA,
+	MC0010_INSTRUCTIONS
+
+}mc0010_instruction_t;
+
+// cost model.
+typedef struct
+{
+	// MCU clock in Hz.
+	uint32_t mcu_hz;
+
+	// MCU cycles for each bus primitive (set data, RS, RW, pulse EN, busy flag read, clock read).
+	uint16_t op_cycles[OLED_HAL_OPS];
+
+	// instruction execution time (busy flag set) in ns.
+	uint32_t exec_ns[MC0010_INSTRUCTIONS];
+
+}mc0010_cost_t;
+
+// counters since the last reset.
+typedef struct
+{
+	uint32_t instructions[MC0010_INSTRUCTIONS];
+
+	// writes received while the busy flag was set.
+	uint32_t busy_violations;
+
+}mc0010_stats_t;
+
+// returns the default cost model (1 MHz MCU).
+mc0010_cost_t mc0010_default_cost(void);
+
+// resets the controller and attaches it to the bus.
+void mc0010_init(mc0010_cost_t const * cost);
+
+// returns the emulated time in ns.
+uint64_t mc0010_now_ns(void);
+
+// advances the emulated time (MCU work outside the bus).
+void mc0010_advance_ns(uint32_t ns);
+
+// returns the counters.
+mc0010_stats_t mc0010_stats(void);
+
+// resets the counters.
+void mc0010_stats_reset(void);
+
+// returns true when the pixel is on.  x and y are 1 based (top left 1,1).
+bool mc0010_pixel(uint8_t x, uint8_t y);
+
+// returns the graphics RAM byte.  x and cy are 1 based.
+uint8_t mc0010_gram(uint8_t x, uint8_t cy);
+
+// returns the DDRAM byte at the address.
+uint8_t mc0010_ddram(uint8_t addr);
+
+// returns true in graphics mode.
+bool mc0010_graphics_mode(void);
+
+// prints the visible display (columns x rows) as text, '#' on and '.' off.
+void mc0010_print(FILE * f, uint8_t columns, uint8_t rows);
+
+#endif /* MC0010EMU_H_ */
@@ -0,0 +1,201 @@
+/*
+ * oledbench.c
+ *
+ * Host benchmark.  Drives the display stack against the MC0010 emulator and
+ * prints the bus traffic and estimated time of each screen update.
+ *
+ */ 
+
+#include <stdio.h>
+#include "mc0010emu.h"
+#include "oledhal_linux.h"
+#include "../cgoled.h"
+#include "../timer.h"
+#include "../timebase.h"
+#include "../slotmachine.h"
+#include "../power.h"
+#include "../anim.h"
+
+// not declared in the headers.
+void roll_bars(uint8_t bar1_idx, uint8_t bar2_idx, uint8_t bar3_idx);
+void TIMER0_COMPA_vect(void);
+void TIMER1_COMPA_vect(void);
+
+// function declarations.
+void run(void);
+bool check_wake(void);
+bool check_resume(void);
+void config_display(void);
+void measure_begin(void);
+void measure_end(char const * name, uint16_t frames);
+
+
+int main(void)
+{
+	mc0010_cost_t cost = mc0010_default_cost();
+	mc0010_init(&cost);
+
+	oled_config();
+	config_display();
+	oled_power_on();
+
+	// start counting.
+	timer_action();
+
+	printf("busy flag mode\n");
+	oled_timed_mode(false);
+	run();
+
+	printf("timed mode\n");
+	oled_timed_mode(true);
+	run();
+
+	printf("queue mode\n");
+	oled_queue_mode(true);
+	run();
+	oled_queue_mode(false);
+
+	mc0010_print(stdout, OLED_PIXEL_COLUMNS, OLED_PIXEL_ROWS);
+
+	bool ok = check_wake();
+	ok = check_resume() && ok;
+
+	return ok ? 0 : 1;
+}
+
+// a wake from power down with the slot machine shown, as power_policy() in main.c, is within
+// POWER_WAKE_MAX_MS.  the millisecond tick is simulated from the emulated time.
+bool check_wake(void)
+{
+	oled_queue_mode(true);
+	slot_hide();
+	oled_power_off();
+	power_down();
+
+	uint64_t begin_ns = mc0010_now_ns();
+
+	oled_power_on();
+	slot_show();
+	oled_flush_wait();
+
+	for (uint64_t ns = mc0010_now_ns() - begin_ns; ns != 0; ns -= (ns < 1000000) ? ns : 1000000)
+	{
+		TIMER0_COMPA_vect();
+	}
+
+	power_wake_done();
+	oled_queue_mode(false);
+
+	bool ok = power_wake_ms() <= POWER_WAKE_MAX_MS;
+
+	printf("wake latency                 ms %u  max %u  %s\n",
+		power_wake_ms(),
+		POWER_WAKE_MAX_MS,
+		ok ? "ok" : "FAILED");
+
+	return ok;
+}
+
+// a count saved before a power cycle and restored at boot carries on when started.
+bool check_resume(void)
+{
+	if (timer_counting())
+		timer_action();
+
+	persist_state_t state;
+	timer_save(&state);
+
+	// boot, the state is restored and the timer started for two seconds.
+	timer_reset();
+	timer_restore(&state);
+
+	timer_action();
+	for (uint8_t i = 0; i != 4; i++)
+	{
+		TIMER1_COMPA_vect();
+		timer_process();
+	}
+	timer_action();
+
+	uint32_t secs = timebase_secs();
+	bool ok = secs == state.timer_secs + 2;
+
+	printf("restore and resume           count %lu -> %lu  %s\n",
+		(unsigned long)state.timer_secs,
+		(unsigned long)secs,
+		ok ? "ok" : "FAILED");
+
+	return ok;
+}
+
+// measures each screen update.
+void run(void)
+{
+	measure_begin();
+	timer_show();
+	measure_end("timer_show", 1);
+
+	// update once a second for a minute.
+	measure_begin();
+	for (uint8_t s = 0; s != 60; s++)
+	{
+		TIMER1_COMPA_vect();
+		timer_process();
+		TIMER1_COMPA_vect();
+		timer_process();
+	}
+	measure_end("timer_process (per second)", 60);
+
+	// switching application, the timer leaves character mode.
+	measure_begin();
+	timer_hide();
+	slot_show();
+	measure_end("slot_show", 1);
+
+	// a spin back to the starting indexes, the millisecond tick is simulated.
+	measure_begin();
+	uint16_t ms = 0;
+	roll_bars(2, 3, 5);
+	while (slot_spinning())
+	{
+		TIMER0_COMPA_vect();
+		slot_process();
+		ms++;
+	}
+	measure_end("roll_bars (per frame)", ms / ANIM_FRAME_MS);
+}
+
+// configures the display the same way as main.c.
+void config_display(void)
+{
+	oled_write_cmd(CMD_FUNC_CONTROL | CMD_FUNC_8BIT | CMD_FUNC_2LINES);
+	oled_cursor_home();
+	oled_incremental_cursor();
+	oled_graphics_mode();
+	oled_clear();
+}
+
+static uint64_t g_begin_ns;
+
+void measure_begin(void)
+{
+	oled_hal_reset();
+	mc0010_stats_reset();
+	g_begin_ns = mc0010_now_ns();
+}
+
+void measure_end(char const * name, uint16_t frames)
+{
+	oled_hal_stats_t bus = oled_hal_stats();
+	mc0010_stats_t emu = mc0010_stats();
+	uint64_t ns = mc0010_now_ns() - g_begin_ns;
+
+	printf("%-28s frames %4u  commands %7.1f  data %7.1f  busy reads %8.1f  us %9.1f  violations %u\n",
+		name,
+		frames,
+		(double)bus.commands / frames,
+		(double)bus.data_bytes / frames,
+		(double)bus.busy_reads / frames,
+		(double)ns / 1000.0 / frames,
+		emu.busy_violations);
+}
@@ -0,0 +1,194 @@
+/*
+ * oledhal_linux.c
+ *
+ * Linux backend for oledhal.h.
+ * The bus lines are kept in variables and every write latched by the enable pulse is logged.
+ * Writes, busy flag and clock reads are passed to the attached device.
+ * Without one the display is never busy and the clock advances a tick per read.
+ *
+ * There are no interrupts, a scheduled clock interrupt runs straight away
+ * after waiting for its ticks on the clock.
+ *
+ */ 
+
+#include "oledhal_linux.h"
+
+// bus lines.
+static uint8_t g_data = 0x00;
+static bool g_rs = false;
+static bool g_rw = false;
+
+// transaction log (ring) and counters.
+static oled_hal_transaction_t g_log[OLED_HAL_LOG_SIZE];
+static uint32_t g_log_total = 0;
+static oled_hal_stats_t g_stats = { 0, 0, 0 };
+
+// attached device.
+static oled_hal_device_t const * g_device = 0;
+
+// clock when no device is attached.
+static uint8_t g_clock = 0;
+
+// scheduled clock interrupt.
+static bool g_scheduled = false;
+static bool g_in_interrupt = false;
+static uint8_t g_schedule_ticks = 0;
+
+// function declarations.
+void bus_op(oled_hal_op_t op);
+
+
+// Sets the bus pins for output.
+void oled_hal_config(void)
+{
+	g_data = 0x00;
+	g_rs = false;
+	g_rw = false;
+}
+
+// Sets the data bus (DB0 to DB7).
+void oled_hal_set_data(uint8_t data)
+{
+	bus_op(OLED_HAL_SET_DATA);
+	g_data = data;
+}
+
+// Selects the register.  false - command register, true - data register.
+void oled_hal_set_rs(bool data_register)
+{
+	bus_op(OLED_HAL_SET_RS);
+	g_rs = data_register;
+}
+
+// Selects read or write.  Reading switches DB7 to input, writing restores it.
+void oled_hal_set_rw(bool read)
+{
+	bus_op(OLED_HAL_SET_RW);
+	g_rw = read;
+}
+
+// Pulses the enable (on, off) to latch a write.
+void oled_hal_pulse_en(void)
+{
+	bus_op(OLED_HAL_PULSE_EN);
+
+	if (g_rw)
+		return;
+
+	oled_hal_transaction_t t = { g_rs, g_data };
+	g_log[g_log_total % OLED_HAL_LOG_SIZE] = t;
+	g_log_total++;
+
+	if (g_rs)
+		g_stats.data_bytes++;
+	else
+		g_stats.commands++;
+
+	if (g_device)
+		g_device->write(g_rs, g_data);
+}
+
+// Pulses the enable and returns the busy flag (DB7).  Requires RS 0 and RW 1.
+bool oled_hal_read_busy(void)
+{
+	bus_op(OLED_HAL_READ_BUSY);
+	g_stats.busy_reads++;
+
+	if (g_device)
+		return g_device->read_busy();
+
+	return false;
+}
+
+// Returns the free running clock (8 bits, wraps).  Used to time instructions.
+uint8_t oled_hal_clock_now(void)
+{
+	bus_op(OLED_HAL_CLOCK_READ);
+
+	if (g_device)
+		return (uint8_t)(g_device->clock_ns() / OLED_HAL_CLOCK_NS);
+
+	return g_clock++;
+}
+
+// Schedules the clock interrupt the given number of ticks from now.
+void oled_hal_schedule(uint8_t ticks)
+{
+	g_scheduled = true;
+	g_schedule_ticks = ticks;
+
+	// rescheduled from the interrupt, the loop below runs it.
+	if (g_in_interrupt)
+		return;
+
+	g_in_interrupt = true;
+
+	while (g_scheduled)
+	{
+		g_scheduled = false;
+
+		uint8_t start = oled_hal_clock_now();
+		while ((uint8_t)(oled_hal_clock_now() - start) < g_schedule_ticks)
+			;
+
+		oled_hal_scheduled();
+	}
+
+	g_in_interrupt = false;
+}
+
+// Cancels the scheduled clock interrupt.
+void oled_hal_schedule_stop(void)
+{
+	g_scheduled = false;
+}
+
+// Switches the free running clock prescaler with the system clock.
+// the host clock does not change.
+void oled_hal_clock_scale(bool fast)
+{
+	(void)fast;
+}
+
+
+// attaches a device to the bus, NULL detaches it (the display is never busy).
+void oled_hal_attach(oled_hal_device_t const * device)
+{
+	g_device = device;
+}
+
+
+// returns the counters since the last reset.
+oled_hal_stats_t oled_hal_stats(void)
+{
+	return g_stats;
+}
+
+// resets the counters and the log.
+void oled_hal_reset(void)
+{
+	oled_hal_stats_t stats = { 0, 0, 0 };
+	g_stats = stats;
+	g_log_total = 0;
+}
+
+// returns the number of transactions in the log (at most OLED_HAL_LOG_SIZE).
+uint16_t oled_hal_log_count(void)
+{
+	return g_log_total < OLED_HAL_LOG_SIZE ? (uint16_t)g_log_total : OLED_HAL_LOG_SIZE;
+}
+
+// returns the logged transaction n (0 is the oldest).
+oled_hal_transaction_t oled_hal_log_at(uint16_t n)
+{
+	uint32_t first = g_log_total - oled_hal_log_count();
+	return g_log[(first + n) % OLED_HAL_LOG_SIZE];
+}
+
+
+// reports a bus primitive to the attached device.
+void bus_op(oled_hal_op_t op)
+{
+	if (g_device)
+		g_device->op(op);
+}
@@ -0,0 +1,81 @@
+/*
+ * oledhal_linux.h
+ *
+ * Linux backend for oledhal.h.
+ * Records every bus transaction so commands and data bytes can be counted per frame.
+ *
+ */ 
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../oledhal.h"
+
+#ifndef OLEDHAL_LINUX_H_
+#define OLEDHAL_LINUX_H_
+
+// number of transactions kept in the log (oldest are overwritten).
+#define OLED_HAL_LOG_SIZE 4096
+
+// a write latched by the enable pulse.
+typedef struct
+{
+	bool rs;
+	uint8_t data;
+
+}oled_hal_transaction_t;
+
+// bus transaction counters.
+typedef struct
+{
+	uint32_t commands;
+	uint32_t data_bytes;
+	uint32_t busy_reads;
+
+}oled_hal_stats_t;
+
+// bus primitives, reported to the attached device.
+typedef enum
+{
+	OLED_HAL_SET_DATA,
+	OLED_HAL_SET_RS,
+	OLED_HAL_SET_RW,
+	OLED_HAL_PULSE_EN,
+	OLED_HAL_READ_BUSY,
+	OLED_HAL_CLOCK_READ,
+	OLED_HAL_OPS
+
+}oled_hal_op_t;
+
+// a device attached to the bus (eg. the MC0010 emulator).
+typedef struct
+{
+	// called for every bus primitive, before it takes effect.
+	void (*op)(oled_hal_op_t op);
+
+	// called for each write latched by the enable pulse.
+	void (*write)(bool rs, uint8_t data);
+
+	// called for each busy flag read, returns the busy flag.
+	bool (*read_busy)(void);
+
+	// called for each clock read, returns the time in ns.
+	uint64_t (*clock_ns)(void);
+
+}oled_hal_device_t;
+
+// attaches a device to the bus, NULL detaches it (the display is never busy).
+void oled_hal_attach(oled_hal_device_t const * device);
+
+// returns the counters since the last reset.
+oled_hal_stats_t oled_hal_stats(void);
+
+// resets the counters and the log.
+void oled_hal_reset(void);
+
+// returns the number of transactions in the log (at most OLED_HAL_LOG_SIZE).
+uint16_t oled_hal_log_count(void);
+
+// returns the logged transaction n (0 is the oldest).
+oled_hal_transaction_t oled_hal_log_at(uint16_t n);
+
+#endif /* OLEDHAL_LINUX_H_ */
@@ -0,0 +1,53 @@
+/*
+ * laps.c
+ *
+ */ 
+
+#include "laps.h"
+
+#define LAPS_MASK (LAPS - 1)
+
+// splits, lap n is held at (n - 1) & LAPS_MASK.
+static uint32_t g_splits[LAPS];
+
+// laps recorded and the time counted at the last one.
+static uint16_t g_count = 0;
+static uint32_t g_last = 0;
+
+
+// clears the laps, the next lap is timed from 0.
+void laps_clear(void)
+{
+	g_count = 0;
+	g_last = 0;
+}
+
+// records a lap at the time counted, in hundredths of a second.
+void laps_record(uint32_t centisecs)
+{
+	// no more laps are recorded after LAPS_MAX.
+	if (g_count == LAPS_MAX)
+		return;
+
+	g_splits[g_count & LAPS_MASK] = centisecs - g_last;
+	g_last = centisecs;
+	g_count++;
+}
+
+// returns the number of laps recorded.
+uint16_t laps_count(void)
+{
+	return g_count;
+}
+
+// returns the number of the oldest lap held, 1 when none have been overwritten.
+uint16_t laps_oldest(void)
+{
+	return (g_count > LAPS) ? g_count - LAPS + 1 : 1;
+}
+
+// returns the split of a lap held, in hundredths of a second.
+uint32_t laps_split(uint16_t lap)
+{
+	return g_splits[(lap - 1) & LAPS_MASK];
+}
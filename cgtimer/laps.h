@@ -0,0 +1,39 @@
+/*
+ * laps.h
+ *
+ * Lap (split) times held in a fixed size ring buffer.
+ *
+ * Laps are recorded with the time counted when the lap button was pressed, and held as the
+ * split from the previous lap. When the buffer is full the oldest lap is overwritten, laps are
+ * numbered from 1 in the order recorded, up to LAPS_MAX.
+ *
+ */ 
+
+
+#ifndef LAPS_H_
+#define LAPS_H_
+
+#include <stdint.h>
+
+// laps held (a power of 2).
+#define LAPS 16
+
+// the largest lap number, the review shows two digits.
+#define LAPS_MAX 99
+
+// clears the laps, the next lap is timed from 0.
+void laps_clear(void);
+
+// records a lap at the time counted, in hundredths of a second.
+void laps_record(uint32_t centisecs);
+
+// returns the number of laps recorded.
+uint16_t laps_count(void);
+
+// returns the number of the oldest lap held, 1 when none have been overwritten.
+uint16_t laps_oldest(void);
+
+// returns the split of a lap held, in hundredths of a second.
+uint32_t laps_split(uint16_t lap);
+
+#endif /* LAPS_H_ */
@@ -11,11 +11,16 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <util/delay.h>
+#include <string.h>
 #include <avr/io.h>
 #include "cgoled.h"
-#include "timer.h"
-#include "slotmachine.h"
+#include "app.h"
+#include "tick.h"
+#include "sched.h"
+#include "power.h"
+#include "buttons.h"
+#include "clock.h"
+#include "persist.h"
 //#include "vgfx.h"   // temporary
 
 // buttons.
@@ -23,160 +28,170 @@
 #define BTN1 PC4
 #define BTN2 PC3
 
-#define APP_TIMER 1
-#define APP_SLOT_MACHINE 2
+// button indexes (see buttons.h).
+#define BUTTON1 0
+#define BUTTON2 1
+#define BUTTON3 2
 
-static uint8_t g_app = APP_TIMER;
+// milliseconds between reading the button events.
+#define INPUT_MS 10
+
+// seconds without a button press before powering down, unless an application is busy.
+#define POWER_DOWN_SECS 60
+
+// seconds between saves of the state while an application is busy, otherwise it is saved when it changes.
+#define PERSIST_BUSY_SECS 60
+
+// seconds since a button was pressed.
+static uint8_t g_idle_secs = 0;
+
+// seconds since the state was saved while an application is busy.
+static uint8_t g_persist_secs = 0;
 
 // function declarations.
 void config_buttons(void);
-bool button1_down(void);
-bool button2_down(void);
-bool button3_down(void);
 void config_display(void);
+void input_process(void);
+void power_policy(void);
+void persist_policy(void);
+void state_save(void);
 
 // button1 -> application action button. 
-//            timer application it is start/stop.
+//            timer application it is start/stop, starting carries on from the count so far.
+//            held, the timer stops and its count and laps are cleared.
+//            in the lap review it scrolls back through the laps.
 //            slot machine application it is start roll.
 
-// button2 -> switch to previous application.
-// button3 -> switch to next application.
+// button2 -> switch to the next application (see app.c).
+// button3 -> timer application it records a lap while counting,
+//            otherwise it switches between the time, seconds and lap review displays.
 
 int main(void)
 {
+	// the idle clock, animation and display writes raise it.
+	clock_config();
+
 	oled_config();
 	config_buttons();
 	config_display();
 	oled_power_on();
 
-	if (g_app == APP_TIMER)
-	{
-		timer_show();
-	}
-	else if (g_app == APP_SLOT_MACHINE)
-	{
-		slot_show();
-	}
+	// the applications add their tasks to the scheduler.
+	tick_config();
+	app_config();
 
-	timer_config();
+	// the state kept over a power cycle is restored before the applications are shown.
+	persist_state_t state;
 
-	bool btn1_down_state = false;
-	bool btn2_down_state = false;
-	bool btn3_down_state = false;
+	if (persist_load(&state))
+		app_restore(&state);
 
-    while (1) 
-    {
-		if (g_app == APP_TIMER)
-		{
-			timer_process();
-		}
-		
-		if (button1_down())
-		{
-			// wait until button is released before processing another press.
-			if (!btn1_down_state)
-			{
-				btn1_down_state = true;
-
-				if (g_app == APP_TIMER)
-				{
-					timer_action();
-				}
-				else if (g_app == APP_SLOT_MACHINE)
-				{
-					slot_action();
-				}
-			}
-		}
-		else
-		{
-			// button is currently released.
-			if (btn1_down_state)
-			{
-				btn1_down_state = false;
-				_delay_ms(20);
-			}
-		}
-		
-		if (button2_down())
+	// interrupts are enabled, write to the display in the background.
+	oled_queue_mode(true);
+
+	app_show();
+
+	sched_start(sched_add(input_process, INPUT_MS), INPUT_MS);
+	sched_start(sched_add(power_policy, 1000), 1000);
+	sched_start(sched_add(persist_policy, 1000), 1000);
+
+	// run the tasks, idling in between.
+	sched_run();
+}
+
+// acts on the button events, the buttons are debounced by the tick interrupt.
+void input_process(void)
+{
+	button_event_t event;
+
+	while (buttons_event(&event))
+	{
+		g_idle_secs = 0;
+
+		if (event.button == BUTTON1 && event.type == BUTTON_LONG)
 		{
-			// wait until button is released before processing another press.
-			if (!btn2_down_state)
-			{
-				btn2_down_state = true;
-				
-				if (g_app == APP_SLOT_MACHINE)
-				{
-					g_app = APP_TIMER;
-					timer_show();
-				}
-				else if (g_app == APP_TIMER)
-				{
-					g_app = APP_SLOT_MACHINE;
-					slot_show();
-				}			
-			}
+			app_long_action();
+			continue;
 		}
-		else
+
+		if (event.type != BUTTON_PRESS)
+			continue;
+
+		if (event.button == BUTTON1)
 		{
-			// button is currently released.
-			if (btn2_down_state)
-			{
-				btn2_down_state = false;
-				_delay_ms(20);
-			}
+			app_action();
 		}
-
-		if (button3_down())
+		else if (event.button == BUTTON2)
 		{
-			// wait until button is released before processing another press.
-			if (!btn3_down_state)
-			{
-				btn3_down_state = true;
-				
-				if (g_app == APP_TIMER)
-				{
-					timer_switch();
-				}
-			}
+			app_next();
 		}
-		else
+		else if (event.button == BUTTON3)
 		{
-			// button is currently released.
-			if (btn3_down_state)
-			{
-				btn3_down_state = false;
-				_delay_ms(20);
-			}
+			app_alt_action(event.ms);
 		}
-
 	}
 }
 
-void config_buttons(void)
+// powers down after a period without button presses, unless an application is busy.
+// the button that wakes the MCU is not acted on.
+// run by the scheduler every second, between ticks the scheduler only idles.
+void power_policy(void)
 {
-	// setup buttons for input.
-	DDRC &= ~(1 << BTN0);
-	DDRC &= ~(1 << BTN1);
-	DDRC &= ~(1 << BTN2);
+	if (app_busy())
+	{
+		g_idle_secs = 0;
+		return;
+	}
+
+	if (++g_idle_secs < POWER_DOWN_SECS)
+		return;
+
+	app_hide();
+	oled_power_off();
+
+	// the state is saved before powering down, the EEPROM interrupt does not run in power down.
+	persist_flush_wait();
+	state_save();
+	persist_flush_wait();
+
+	power_down();
+
+	oled_power_on();
+	app_show();
+	power_wake_done();
+
+	buttons_ignore_held();
+	g_idle_secs = 0;
 }
 
-// returns true when button 1 is pressed.
-bool button1_down(void)
+// saves the state when it has changed, while an application is busy only every PERSIST_BUSY_SECS.
+// run by the scheduler every second, the save is written in the background.
+void persist_policy(void)
 {
-	return !(PINC & (1 << BTN0));
+	if (app_busy() && ++g_persist_secs < PERSIST_BUSY_SECS)
+		return;
+
+	g_persist_secs = 0;
+	state_save();
 }
 
-// returns true when button 2 is pressed.
-bool button2_down(void)
+// gathers the state from the applications and saves it.
+void state_save(void)
 {
-	return !(PINC & (1 << BTN1));
+	persist_state_t state;
+	memset(&state, 0, sizeof(state));
+
+	app_save(&state);
+	persist_save(&state);
 }
 
-// returns true when button 3 is pressed.
-bool button3_down(void)
+void config_buttons(void)
 {
-	return !(PINC & (1 << BTN2));
+	// setup buttons for input.
+	buttons_config(BTN0, BTN1, BTN2);
+
+	// any button wakes the MCU from power down.
+	power_config((1 << BTN0) | (1 << BTN1) | (1 << BTN2));
 }
 
 
@@ -186,6 +201,7 @@ bool button3_down(void)
 // use 8 bit mode (requires 8 pins for databus).
 // auto increment cursor position after writing a character or pixels.
 // switches the display to graphics mode which makes the character modes irrelevant until mode is switched.
+// uses timed writes instead of checking the busy flag before each write.
 //
 void config_display(void)
 {
@@ -194,6 +210,7 @@ void config_display(void)
 	oled_incremental_cursor();
 	oled_graphics_mode();
 	oled_clear();
+	oled_timed_mode(true);
 }
 
 // create the up arrow character.
@@ -6,66 +6,45 @@
  */ 
 
 #include "numeric5x8.h"
+#include "font5x8.h"
+#include <avr/pgmspace.h>
 
-// characters 8x5 (5 columns) pixels.
-static const uint8_t g_zero[] = { 0x3E, 0x51, 0x49, 0x45, 0x3E };
-static const uint8_t g_one[] = { 0x00, 0x42, 0x7F, 0x40, 0x00 };
-static const uint8_t g_two[] = { 0x42, 0x61, 0x51, 0x49, 0x46 };
-static const uint8_t g_three[] = { 0x21, 0x41, 0x45, 0x4B, 0x31 };
-static const uint8_t g_four[] = { 0x18, 0x14, 0x12, 0x7F, 0x10 };
-static const uint8_t g_five[] = { 0x27, 0x45, 0x45, 0x45, 0x39 };
-static const uint8_t g_six[] = { 0x3C, 0x4A, 0x49, 0x49, 0x30 };
-static const uint8_t g_seven[] = { 0x01, 0x01, 0x71, 0x0D, 0x03 };
-static const uint8_t g_eight[] = { 0x36, 0x49, 0x49, 0x49, 0x36 };
-static const uint8_t g_nine[] = { 0x06, 0x49, 0x49, 0x29, 0x1E };
+// splits the 5 columns of a glyph into the first page and next page bytes.
+#define PAGED(...) PAGED_COLUMNS(__VA_ARGS__)
+#define PAGED_COLUMNS(a, b, c, d, e) \
+	{ DIGIT5X8_UPPER(a), DIGIT5X8_UPPER(b), DIGIT5X8_UPPER(c), DIGIT5X8_UPPER(d), DIGIT5X8_UPPER(e), \
+	  DIGIT5X8_LOWER(a), DIGIT5X8_LOWER(b), DIGIT5X8_LOWER(c), DIGIT5X8_LOWER(d), DIGIT5X8_LOWER(e) }
 
-// returns pointer to digit.
+// digits pre-shifted to DIGIT5X8_BASELINE_Y, held in program memory.
+static const uint8_t g_paged[10][2 * DIGIT5X8_COLUMNS] PROGMEM =
+{
+	PAGED(FONT5X8_DIGIT_0),
+	PAGED(FONT5X8_DIGIT_1),
+	PAGED(FONT5X8_DIGIT_2),
+	PAGED(FONT5X8_DIGIT_3),
+	PAGED(FONT5X8_DIGIT_4),
+	PAGED(FONT5X8_DIGIT_5),
+	PAGED(FONT5X8_DIGIT_6),
+	PAGED(FONT5X8_DIGIT_7),
+	PAGED(FONT5X8_DIGIT_8),
+	PAGED(FONT5X8_DIGIT_9),
+};
+
+// returns pointer to digit (program memory).
+// the digits are the '0' to '9' glyphs of the font atlas.
 uint8_t const * const digit5x8_ptr(uint8_t digit)
 {
-	uint8_t const * addr = &g_zero[0];
-
-	switch(digit)
-	{
-		case 0:
-		addr = &g_zero[0];
-		break;
-
-		case 1:
-		addr = &g_one[0];
-		break;
-
-		case 2:
-		addr = &g_two[0];
-		break;
-
-		case 3:
-		addr = &g_three[0];
-		break;
-
-		case 4:
-		addr = &g_four[0];
-		break;
+	if (digit > 9)
+		digit = 0;
 
-		case 5:
-		addr = &g_five[0];
-		break;
-
-		case 6:
-		addr = &g_six[0];
-		break;
-
-		case 7:
-		addr = &g_seven[0];
-		break;
-
-		case 8:
-		addr = &g_eight[0];
-		break;
+	return font5x8_ptr('0' + digit);
+}
 
-		case 9:
-		addr = &g_nine[0];
-		break;
-	}
+// returns pointer to the pre-shifted digit (program memory).
+uint8_t const * digit5x8_paged_ptr(uint8_t digit)
+{
+	if (digit > 9)
+		digit = 0;
 
-	return addr;
+	return &g_paged[digit][0];
 }
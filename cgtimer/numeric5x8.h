@@ -8,8 +8,38 @@
 
 #ifndef NUMERIC5X8_H_
 #define NUMERIC5X8_H_
-#endif /* NUMERIC5X8_H_ */
 
 #include <stdint.h>
 
+// pixel y co-ordinate of the top row of the pre-shifted digits (build-time option).
+// the digit tables are emitted already split into the two display pages for this baseline,
+// so drawing them needs no shifting (see vgfx_fb_paged_at_P).
+#ifndef DIGIT5X8_BASELINE_Y
+#define DIGIT5X8_BASELINE_Y 6
+#endif
+
+#if DIGIT5X8_BASELINE_Y < 1 || DIGIT5X8_BASELINE_Y > 9
+#error "DIGIT5X8_BASELINE_Y must place the digits within the display (1 to 9)"
+#endif
+
+// first page (1 or 2) covered by the pre-shifted digits and the shift within it.
+#define DIGIT5X8_PAGE  ((DIGIT5X8_BASELINE_Y - 1) / 8 + 1)
+#define DIGIT5X8_SHIFT ((DIGIT5X8_BASELINE_Y - 1) % 8)
+
+// pixel rows covered in the first page, the rest of the digit is in the next page.
+#define DIGIT5X8_MASK ((uint8_t)(0xFF << DIGIT5X8_SHIFT))
+
+// splits a column of pixels into the first and next page bytes at the baseline.
+#define DIGIT5X8_UPPER(pixels) ((uint8_t)((pixels) << DIGIT5X8_SHIFT))
+#define DIGIT5X8_LOWER(pixels) ((uint8_t)((pixels) >> (8 - DIGIT5X8_SHIFT)))
+
+#define DIGIT5X8_COLUMNS 5
+
+// returns pointer to digit, the 5 columns are held in program memory (use the _P functions).
 uint8_t const * const digit5x8_ptr(uint8_t digit);
+
+// returns pointer to the pre-shifted digit (program memory).
+// the 5 columns of the first page are followed by the 5 columns of the next page.
+uint8_t const * digit5x8_paged_ptr(uint8_t digit);
+
+#endif /* NUMERIC5X8_H_ */
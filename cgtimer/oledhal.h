@@ -0,0 +1,63 @@
+/*
+ * oledhal.h
+ *
+ * Hardware abstraction of the MC0010 bus used by cgoled.
+ *
+ * AVR builds use oledhal_avr.h, the pin mapping is declared in cgoled.h.
+ * Other builds use host/oledhal_linux.c which records every bus transaction
+ * so the display stack can be compiled and measured on a developer machine.
+ *
+ */ 
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef OLEDHAL_H_
+#define OLEDHAL_H_
+
+#if defined(__AVR__)
+
+// static inline bus primitives.
+#include "oledhal_avr.h"
+
+#else
+
+// Sets the bus pins for output.
+void oled_hal_config(void);
+
+// Sets the data bus (DB0 to DB7).
+void oled_hal_set_data(uint8_t data);
+
+// Selects the register.  false - command register, true - data register.
+void oled_hal_set_rs(bool data_register);
+
+// Selects read or write.  Reading switches DB7 to input, writing restores it.
+void oled_hal_set_rw(bool read);
+
+// Pulses the enable (on, off) to latch a write.
+void oled_hal_pulse_en(void);
+
+// Pulses the enable and returns the busy flag (DB7).  Requires RS 0 and RW 1.
+bool oled_hal_read_busy(void);
+
+// Free running clock tick period in nano seconds.
+#define OLED_HAL_CLOCK_NS 1000
+
+// Returns the free running clock (8 bits, wraps).  Used to time instructions.
+uint8_t oled_hal_clock_now(void);
+
+// Schedules the clock interrupt the given number of ticks from now.
+void oled_hal_schedule(uint8_t ticks);
+
+// Cancels the scheduled clock interrupt.
+void oled_hal_schedule_stop(void);
+
+// Switches the free running clock prescaler with the system clock (see clock.h).
+void oled_hal_clock_scale(bool fast);
+
+#endif
+
+// Called from the clock interrupt scheduled by oled_hal_schedule(), implemented by the driver.
+void oled_hal_scheduled(void);
+
+#endif /* OLEDHAL_H_ */
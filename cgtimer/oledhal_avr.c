@@ -0,0 +1,16 @@
+/*
+ * oledhal_avr.c
+ *
+ * AVR backend for oledhal.h, the clock interrupt.
+ *
+ */ 
+
+#include "oledhal.h"
+#include <avr/interrupt.h>
+
+// Interrupt service routine.
+// When timer2 reaches the time scheduled by oled_hal_schedule().
+ISR(TIMER2_COMPA_vect)
+{
+	oled_hal_scheduled();
+}
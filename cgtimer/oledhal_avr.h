@@ -0,0 +1,217 @@
+/*
+ * oledhal_avr.h
+ *
+ * AVR backend for oledhal.h.
+ * The primitives are static inline so each bus access compiles to the port instructions.
+ *
+ */ 
+
+#ifndef F_CPU				// if F_CPU was not defined in Project -> Properties
+#define F_CPU 1000000UL		// define it now as 1 MHz unsigned long
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "cgoled.h"
+#include "clock.h"
+
+#ifndef OLEDHAL_AVR_H_
+#define OLEDHAL_AVR_H_
+
+// timer2 is the free running clock used to time instructions.
+// the prescaler keeps the tick period at about a micro second.
+#if F_CPU >= 8000000UL
+#define OLED_HAL_CLOCK_PRESCALER 8
+#define OLED_HAL_CLOCK_CS (1 << CS21)
+#else
+#define OLED_HAL_CLOCK_PRESCALER 1
+#define OLED_HAL_CLOCK_CS (1 << CS20)
+#endif
+
+// the prescaler at the fast clock (see clock.h), the tick period is the same.
+#define OLED_HAL_CLOCK_CS_FAST (1 << CS21)
+
+// Free running clock tick period in nano seconds.
+#define OLED_HAL_CLOCK_NS (OLED_HAL_CLOCK_PRESCALER * 1000000000UL / F_CPU)
+
+// Data bus wired DB0..DB7 to pins 0..7 in order.
+#if (OLED_DB0 == 0) && (OLED_DB1 == 1) && (OLED_DB2 == 2) && (OLED_DB3 == 3) && \
+	(OLED_DB4 == 4) && (OLED_DB5 == 5) && (OLED_DB6 == 6) && (OLED_DB7 == 7)
+#define OLED_HAL_DATA_BUS_ORDERED
+#endif
+
+// Data bus wired to a single port.
+// The register addresses are constants, the compiler removes the comparison.
+#define OLED_HAL_DATA_BUS_SINGLE_PORT \
+	(&OLED_PORT_DB0 == &OLED_PORT_DB1 && &OLED_PORT_DB0 == &OLED_PORT_DB2 && \
+	 &OLED_PORT_DB0 == &OLED_PORT_DB3 && &OLED_PORT_DB0 == &OLED_PORT_DB4 && \
+	 &OLED_PORT_DB0 == &OLED_PORT_DB5 && &OLED_PORT_DB0 == &OLED_PORT_DB6 && \
+	 &OLED_PORT_DB0 == &OLED_PORT_DB7)
+
+
+// Sets the ports using the defines declared in cgoled.h.
+static inline void oled_hal_config(void)
+{
+	// setup port D pins for output.
+	OLED_DDR_DB0 |= (1 << OLED_DB0);
+	OLED_DDR_DB1 |= (1 << OLED_DB1);
+	OLED_DDR_DB2 |= (1 << OLED_DB2);
+	OLED_DDR_DB3 |= (1 << OLED_DB3);
+	OLED_DDR_DB4 |= (1 << OLED_DB4);
+	OLED_DDR_DB5 |= (1 << OLED_DB5);
+	OLED_DDR_DB6 |= (1 << OLED_DB6);
+	OLED_DDR_DB7 |= (1 << OLED_DB7);
+
+	// setup Port B pins for output.
+	OLED_DDR_RS |= (1 << OLED_RS);
+	OLED_DDR_RW |= (1 << OLED_RW);
+	OLED_DDR_EN |= (1 << OLED_EN);
+
+	// timer2 normal mode (free running), no interrupts.
+	TCCR2A = 0x00;
+	TCCR2B = OLED_HAL_CLOCK_CS;
+}
+
+// Switches the free running clock prescaler with the system clock (see clock.h).
+static inline void oled_hal_clock_scale(bool fast)
+{
+	TCCR2B = fast ? OLED_HAL_CLOCK_CS_FAST : OLED_HAL_CLOCK_CS;
+}
+
+// The enable pulse is held for a cycle more at clocks of 4 MHz and over.
+// Each port instruction is 2 cycles, the pulse is then at least 375 ns wide (250 ns minimum).
+static inline void oled_hal_en_hold(void)
+{
+#if F_CPU >= 4000000UL || defined(CLOCK_SCALING)
+	__asm__ __volatile__ ("nop");
+#endif
+}
+
+// Sets the data registers to the given data.
+static inline void oled_hal_set_data(uint8_t data)
+{
+#ifdef OLED_HAL_DATA_BUS_ORDERED
+	// DB0..DB7 in order on one port, a single store sets the bus.
+	if (OLED_HAL_DATA_BUS_SINGLE_PORT)
+	{
+		OLED_PORT_DB0 = data;
+		return;
+	}
+#endif
+
+	if (data & (1 << 7))
+		OLED_PORT_DB7 |= (1 << OLED_DB7);
+	else
+		OLED_PORT_DB7 &= ~(1 << OLED_DB7);
+
+	if (data & (1 << 6))
+		OLED_PORT_DB6 |= (1 << OLED_DB6);
+	else
+		OLED_PORT_DB6 &= ~(1 << OLED_DB6);
+
+	if (data & (1 << 5))
+		OLED_PORT_DB5 |= (1 << OLED_DB5);
+	else
+		OLED_PORT_DB5 &= ~(1 << OLED_DB5);
+
+	if (data & (1 << 4))
+		OLED_PORT_DB4 |= (1 << OLED_DB4);
+	else
+		OLED_PORT_DB4 &= ~(1 << OLED_DB4);
+
+	if (data & (1 << 3))
+		OLED_PORT_DB3 |= (1 << OLED_DB3);
+	else
+		OLED_PORT_DB3 &= ~(1 << OLED_DB3);
+
+	if (data & (1 << 2))
+		OLED_PORT_DB2 |= (1 << OLED_DB2);
+	else
+		OLED_PORT_DB2 &= ~(1 << OLED_DB2);
+
+	if (data & (1 << 1))
+		OLED_PORT_DB1 |= (1 << OLED_DB1);
+	else
+		OLED_PORT_DB1 &= ~(1 << OLED_DB1);
+
+	if (data & 1)
+		OLED_PORT_DB0 |= (1 << OLED_DB0);
+	else
+		OLED_PORT_DB0 &= ~(1 << OLED_DB0);
+}
+
+// Selects the register.  false - command register, true - data register.
+static inline void oled_hal_set_rs(bool data_register)
+{
+	if (data_register)
+		OLED_PORT_RS |= (1 << OLED_RS);
+	else
+		OLED_PORT_RS &= ~(1 << OLED_RS);
+}
+
+// Selects read or write.  Reading switches DB7 to input, writing restores it.
+static inline void oled_hal_set_rw(bool read)
+{
+	if (read)
+	{
+		// Set data bus bit 7 as input.
+		OLED_DDR_DB7 &= ~(1 << OLED_DB7);
+		OLED_PORT_RW |= (1 << OLED_RW);
+	}
+	else
+	{
+		// restore data bus bit 7 as output.
+		OLED_DDR_DB7 |= (1 << OLED_DB7);
+		OLED_PORT_RW &= ~(1 << OLED_RW);
+	}
+}
+
+// Pulses the enable (on, off) to latch a write.
+static inline void oled_hal_pulse_en(void)
+{
+	OLED_PORT_EN |= (1 << OLED_EN);
+	oled_hal_en_hold();
+	OLED_PORT_EN &= ~(1 << OLED_EN);
+}
+
+// Pulses the enable and returns the busy flag (DB7).  Requires RS 0 and RW 1.
+static inline bool oled_hal_read_busy(void)
+{
+	OLED_PORT_EN |= (1 << OLED_EN);
+	oled_hal_en_hold();
+	OLED_PORT_EN &= ~(1 << OLED_EN);
+
+	return (OLED_PIN_DB7 & (1 << OLED_DB7)) != 0;
+}
+
+// Returns the free running clock (8 bits, wraps).  Used to time instructions.
+static inline uint8_t oled_hal_clock_now(void)
+{
+	return TCNT2;
+}
+
+// Schedules the clock interrupt the given number of ticks from now.
+// (timer2 compare A, see oledhal_avr.c)
+// the old compare match is cleared before the new one is set, a match while the interrupt
+// is being enabled is kept. interrupts are held off so nothing delays the write past the match.
+static inline void oled_hal_schedule(uint8_t ticks)
+{
+	uint8_t sreg = SREG;
+	cli();
+
+	TIFR2 = (1 << OCF2A);
+	OCR2A = TCNT2 + ticks;
+	TIMSK2 |= (1 << OCIE2A);
+
+	SREG = sreg;
+}
+
+// Cancels the scheduled clock interrupt.
+static inline void oled_hal_schedule_stop(void)
+{
+	TIMSK2 &= ~(1 << OCIE2A);
+}
+
+#endif /* OLEDHAL_AVR_H_ */
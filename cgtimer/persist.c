@@ -0,0 +1,179 @@
+/*
+ * persist.c
+ *
+ */ 
+
+#include "persist.h"
+#include <stddef.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/crc16.h>
+
+// a saved state, the CRC covers the bytes before it.
+typedef struct
+{
+	persist_state_t state;
+	uint16_t seq;
+	uint8_t crc;
+}record_t;
+
+// a record must fit its slot.
+typedef char record_fits_slot[(sizeof(record_t) <= PERSIST_SLOT_SIZE) ? 1 : -1];
+
+// the slot written next, and its sequence number.
+static uint8_t g_slot = 0;
+static uint16_t g_seq = 0;
+
+// the state last saved, unchanged states are not written again.
+static persist_state_t g_saved;
+static bool g_saved_valid = false;
+
+// the record being written by the EEPROM ready interrupt, its bytes written so far.
+// the interrupt is enabled until the last byte is written.
+static record_t g_record;
+static uint16_t g_address = 0;
+static uint8_t g_written = 0;
+
+// function declarations.
+uint8_t record_crc(record_t const * record);
+void eeprom_read(uint16_t address, uint8_t * data, uint8_t n);
+
+
+// loads the newest state saved, returns false when there is none.
+bool persist_load(persist_state_t * state)
+{
+	record_t record;
+	bool found = false;
+
+	for (uint8_t slot = 0; slot != PERSIST_SLOTS; slot++)
+	{
+		eeprom_read(slot * PERSIST_SLOT_SIZE, (uint8_t *)&record, sizeof(record_t));
+
+		if (record.crc != record_crc(&record))
+			continue;
+
+		// sequence numbers wrap, the newest is ahead of the others by less than half the range.
+		if (!found || (int16_t)(record.seq - g_seq) >= 0)
+		{
+			found = true;
+			g_slot = slot;
+			g_seq = record.seq;
+			*state = record.state;
+		}
+	}
+
+	if (!found)
+		return false;
+
+	// the next save follows the newest record.
+	g_slot = (g_slot + 1) % PERSIST_SLOTS;
+	g_seq++;
+
+	g_saved = *state;
+	g_saved_valid = true;
+
+	return true;
+}
+
+// saves the state in the background when it has changed.
+// nothing is saved while a save is being written, returns false then.
+bool persist_save(persist_state_t const * state)
+{
+	if (persist_busy())
+		return false;
+
+	if (g_saved_valid && memcmp(state, &g_saved, sizeof(persist_state_t)) == 0)
+		return true;
+
+	g_record.seq = g_seq++;
+	g_record.state = *state;
+	g_record.crc = record_crc(&g_record);
+
+	g_address = g_slot * PERSIST_SLOT_SIZE;
+	g_slot = (g_slot + 1) % PERSIST_SLOTS;
+
+	g_saved = *state;
+	g_saved_valid = true;
+
+	// the interrupt writes the record.
+	g_written = 0;
+	EECR |= (1 << EERIE);
+
+	return true;
+}
+
+// returns true while a save is being written.
+bool persist_busy(void)
+{
+	return (EECR & (1 << EERIE)) != 0;
+}
+
+// waits until a save being written is finished.
+void persist_flush_wait(void)
+{
+	while (persist_busy())
+		;
+}
+
+// Interrupt service routine.
+// When the EEPROM is ready for the next byte.
+ISR(EE_READY_vect)
+{
+	uint8_t const * bytes = (uint8_t const *)&g_record;
+	uint8_t i = g_written;
+
+	// bytes that already hold the value are not written again.
+	while (i != sizeof(record_t))
+	{
+		EEAR = g_address + i;
+		EECR |= (1 << EERE);
+
+		if (EEDR != bytes[i])
+			break;
+
+		i++;
+	}
+
+	if (i == sizeof(record_t))
+	{
+		// the record is written.
+		EECR &= ~(1 << EERIE);
+		return;
+	}
+
+	// erase and write the byte, the write must start within 4 cycles of the enable.
+	EEDR = bytes[i];
+	EECR |= (1 << EEMPE);
+	EECR |= (1 << EEPE);
+
+	g_written = i + 1;
+}
+
+// returns the CRC of a record's bytes before the CRC.
+uint8_t record_crc(record_t const * record)
+{
+	uint8_t const * bytes = (uint8_t const *)record;
+	uint8_t crc = 0;
+
+	for (uint8_t i = 0; i != offsetof(record_t, crc); i++)
+	{
+		crc = _crc8_ccitt_update(crc, bytes[i]);
+	}
+
+	return crc;
+}
+
+// reads bytes from the EEPROM, waiting for a write in progress.
+void eeprom_read(uint16_t address, uint8_t * data, uint8_t n)
+{
+	while (EECR & (1 << EEPE))
+		;
+
+	for (uint8_t i = 0; i != n; i++)
+	{
+		EEAR = address + i;
+		EECR |= (1 << EERE);
+		data[i] = EEDR;
+	}
+}
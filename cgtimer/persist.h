@@ -0,0 +1,50 @@
+/*
+ * persist.h
+ *
+ * State kept over a power cycle in the EEPROM.
+ *
+ * Each save is a record with a sequence number and a CRC, written to the next slot of a ring
+ * of slots covering the EEPROM so the writes are spread over every cell (wear levelling).
+ * At boot the valid record with the newest sequence number is loaded, a record torn by a
+ * power cut fails its CRC and the one before it is used.
+ *
+ * A record is written in the background, a byte each EEPROM ready interrupt (about 3.3 ms
+ * a byte), bytes that already hold the value are skipped.
+ *
+ */ 
+
+
+#ifndef PERSIST_H_
+#define PERSIST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// EEPROM slots in the ring and the bytes in each (the ATmega328P has 1 KB).
+#define PERSIST_SLOTS 64
+#define PERSIST_SLOT_SIZE 16
+
+// the state kept over a power cycle.
+typedef struct
+{
+	uint32_t timer_secs;	// seconds counted.
+	int16_t timer_trim;		// oscillator trim in ppm (see timebase_trim()).
+	uint8_t timer_display;	// timer display mode.
+	uint8_t bars[3];		// slot machine reel indexes.
+	uint8_t score;			// slot machine score.
+}persist_state_t;
+
+// loads the newest state saved, returns false when there is none.
+bool persist_load(persist_state_t * state);
+
+// saves the state in the background when it has changed.
+// nothing is saved while a save is being written, returns false then.
+bool persist_save(persist_state_t const * state);
+
+// returns true while a save is being written.
+bool persist_busy(void);
+
+// waits until a save being written is finished.
+void persist_flush_wait(void);
+
+#endif /* PERSIST_H_ */
@@ -0,0 +1,76 @@
+/*
+ * power.c
+ *
+ */ 
+
+#include "power.h"
+#include "tick.h"
+#include "cgoled.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+// tick when the MCU woke and the longest wake latency.
+static uint16_t g_wake_tick = 0;
+static uint16_t g_wake_ms_max = 0;
+
+
+// configures the PORTC pins (mask of PCx bits) that wake the MCU from power down.
+void power_config(uint8_t portc_pins)
+{
+	// PORTC pins are pin change interrupts PCINT8 to PCINT14, in the same bit order.
+	PCMSK1 = portc_pins;
+
+	// the ADC, TWI, SPI, USART and analog comparator are not used, they are switched off.
+	PRR |= (1 << PRADC) | (1 << PRTWI) | (1 << PRSPI) | (1 << PRUSART0);
+	ACSR |= (1 << ACD);
+}
+
+// pin change on a wake pin, only used to wake the MCU.
+ISR(PCINT1_vect)
+{
+}
+
+// powers down until one of the wake pins changes.
+void power_down(void)
+{
+	oled_flush_wait();
+
+	// clear a change seen before sleeping, then enable the wake interrupt.
+	PCIFR = (1 << PCIF1);
+	PCICR |= (1 << PCIE1);
+
+	set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+
+	cli();
+	sleep_enable();
+#ifdef sleep_bod_disable
+	// the brown out detector is off while powered down.
+	sleep_bod_disable();
+#endif
+	sei();
+	sleep_cpu();
+	sleep_disable();
+
+	PCICR &= ~(1 << PCIE1);
+
+	// the tick stopped while powered down, it restarts from here.
+	g_wake_tick = tick_now();
+}
+
+// ends a wake, measures the latency once the display writes queued since waking are done.
+void power_wake_done(void)
+{
+	oled_flush_wait();
+
+	uint16_t ms = tick_now() - g_wake_tick;
+
+	if (ms > g_wake_ms_max)
+		g_wake_ms_max = ms;
+}
+
+// returns the longest wake latency measured (milliseconds).
+uint16_t power_wake_ms(void)
+{
+	return g_wake_ms_max;
+}
@@ -0,0 +1,37 @@
+/*
+ * power.h
+ *
+ * Power down sleep, woken by a pin change on the buttons.
+ *
+ * In power down the oscillator and timers stop, only a pin change (or reset) wakes the MCU.
+ * The timers carry on from where they stopped, so time spent powered down is not counted.
+ *
+ * Wake latency is measured from the pin change interrupt to the display having been redrawn.
+ * It is bounded by the oscillator start-up (6 clocks from power down with the internal RC
+ * oscillator) plus the display writes queued by the wake, no delays are used.
+ *
+ */ 
+
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include <stdint.h>
+
+// longest wake latency expected (milliseconds), a full slot machine redraw takes about 8 ms.
+#define POWER_WAKE_MAX_MS 16
+
+// configures the PORTC pins (mask of PCx bits) that wake the MCU from power down.
+void power_config(uint8_t portc_pins);
+
+// powers down until one of the wake pins changes.
+// the display write queue is drained first, its interrupt timer stops in power down.
+void power_down(void);
+
+// ends a wake, measures the latency once the display writes queued since waking are done.
+void power_wake_done(void);
+
+// returns the longest wake latency measured (milliseconds).
+uint16_t power_wake_ms(void);
+
+#endif /* POWER_H_ */
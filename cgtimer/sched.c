@@ -0,0 +1,126 @@
+/*
+ * sched.c
+ *
+ */ 
+
+#include "sched.h"
+#include "tick.h"
+#include <stdbool.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+typedef struct
+{
+	sched_fn_t fn;
+	uint16_t period;
+	uint16_t deadline;		// tick the task is next due.
+	bool started;
+}task_t;
+
+static task_t g_tasks[SCHED_TASKS];
+static uint8_t g_task_count = 0;
+
+// function declarations.
+bool run_due(uint16_t * next);
+void idle(uint16_t deadline);
+
+
+// adds a task run every period milliseconds, returns the task to start and stop it.
+uint8_t sched_add(sched_fn_t fn, uint16_t period_ms)
+{
+	if (g_task_count == SCHED_TASKS)
+		return SCHED_TASKS;
+
+	task_t * task = &g_tasks[g_task_count];
+
+	task->fn = fn;
+	task->period = period_ms;
+	task->started = false;
+
+	return g_task_count++;
+}
+
+// starts the task, it first runs after the delay then every period.
+void sched_start(uint8_t task, uint16_t delay_ms)
+{
+	if (task >= g_task_count)
+		return;
+
+	g_tasks[task].deadline = tick_now() + delay_ms;
+	g_tasks[task].started = true;
+}
+
+// stops the task.
+void sched_stop(uint8_t task)
+{
+	if (task >= g_task_count)
+		return;
+
+	g_tasks[task].started = false;
+}
+
+// runs the tasks as they become due, never returns.
+void sched_run(void)
+{
+	while (1)
+	{
+		uint16_t next;
+
+		if (!run_due(&next))
+		{
+			idle(next);
+		}
+	}
+}
+
+// runs each task that is due in the order they were added.
+// returns false when none were due, next is then the earliest deadline.
+bool run_due(uint16_t * next)
+{
+	bool ran = false;
+	uint16_t now = tick_now();
+
+	// when nothing is started, wake again within a second.
+	*next = now + 1000;
+
+	for (uint8_t i = 0; i != g_task_count; i++)
+	{
+		task_t * task = &g_tasks[i];
+
+		if (!task->started)
+			continue;
+
+		if ((int16_t)(now - task->deadline) >= 0)
+		{
+			// the next deadline keeps to the period, a task late by more than a period skips the missed runs.
+			task->deadline += task->period;
+
+			if ((int16_t)(now - task->deadline) >= 0)
+				task->deadline = now + task->period;
+
+			task->fn();
+			ran = true;
+		}
+		else if ((int16_t)(task->deadline - *next) < 0)
+		{
+			*next = task->deadline;
+		}
+	}
+
+	return ran;
+}
+
+// idles the CPU until the deadline, the tick interrupt wakes it each millisecond.
+void idle(uint16_t deadline)
+{
+	set_sleep_mode(SLEEP_MODE_IDLE);
+
+	while (!tick_reached(deadline))
+	{
+		cli();
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+	}
+}
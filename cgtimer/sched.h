@@ -0,0 +1,36 @@
+/*
+ * sched.h
+ *
+ * Cooperative scheduler driven by the millisecond tick (see tick.h).
+ *
+ * Tasks are functions run every period milliseconds once started.
+ * A task runs to completion, the next task runs when it returns.
+ * When no task is due the CPU idles until the next deadline.
+ *
+ */ 
+
+
+#ifndef SCHED_H_
+#define SCHED_H_
+
+#include <stdint.h>
+
+// most tasks that can be added.
+#define SCHED_TASKS 8
+
+typedef void (*sched_fn_t)(void);
+
+// adds a task run every period milliseconds, returns the task to start and stop it.
+// the task is stopped until sched_start(), SCHED_TASKS is returned when there is no room.
+uint8_t sched_add(sched_fn_t fn, uint16_t period_ms);
+
+// starts the task, it first runs after the delay then every period.
+void sched_start(uint8_t task, uint16_t delay_ms);
+
+// stops the task.
+void sched_stop(uint8_t task);
+
+// runs the tasks as they become due, never returns.
+void sched_run(void);
+
+#endif /* SCHED_H_ */
@@ -12,9 +12,12 @@
 #include "slotmachine.h"
 #include <stdint.h>
 #include <stdlib.h>
-#include <util/delay.h>
+#include <avr/pgmspace.h>
 #include "vgfx.h"
 #include "cgoled.h"
+#include "anim.h"
+#include "sched.h"
+#include "clock.h"
 
 #define TV 1
 #define GHOST 2
@@ -31,6 +34,19 @@
 #define BAR_IMAGES 12
 #define BAR_Y_SIZE ( (IMAGE_Y_SIZE + 1) * BAR_IMAGES )
 
+#define REELS 3
+
+// spin timing in animation frames (see ANIM_FRAME_MS).
+// each reel stops SPIN_STAGGER_FRAMES after the one before and turns once more.
+#define SPIN_FRAMES 60
+#define SPIN_STAGGER_FRAMES 20
+#define SPIN_EASE_FRAMES 30
+#define SPIN_TURNS 2
+
+// reel strip words per column.
+// a 16 row window starts in any word up to the last bar row and ends in the word after.
+#define STRIP_WORDS ( (BAR_Y_SIZE - 1) / 16 + 2 )
+
 // Start = +50.
 // Play  = -1
 //
@@ -51,28 +67,98 @@
 //TV, TV, GHOST, GHOST, BALL, BALL, FLAG, INVADER, INVADER, UMBRELLA, INSECT, INSECT
 //TV, TV, GHOST, GHOST, BALL, FLAG, INVADER, INVADER, UMBRELLA, UMBRELLA, INSECT, INSECT
 
-static const uint8_t g_bar1[] = { TV, BALL, GHOST, INSECT, GHOST, UMBRELLA, INSECT, TV, INVADER, FLAG, UMBRELLA, INVADER };
-static const uint8_t g_bar2[] = { GHOST, BALL, GHOST, TV, UMBRELLA, TV, BALL, INVADER, FLAG, INSECT, INVADER, INSECT };
-static const uint8_t g_bar3[] = { TV, INSECT, BALL, GHOST, UMBRELLA, INVADER, GHOST, INSECT, TV, INVADER, FLAG, UMBRELLA };
+//
+// the bars are listed once as X(image, index, ...) so both the image tables and reel strips come from them.
+#define BAR1(X, c, w) X(TV, 0, c, w) X(BALL, 1, c, w) X(GHOST, 2, c, w) X(INSECT, 3, c, w) X(GHOST, 4, c, w) X(UMBRELLA, 5, c, w) \
+	X(INSECT, 6, c, w) X(TV, 7, c, w) X(INVADER, 8, c, w) X(FLAG, 9, c, w) X(UMBRELLA, 10, c, w) X(INVADER, 11, c, w)
+#define BAR2(X, c, w) X(GHOST, 0, c, w) X(BALL, 1, c, w) X(GHOST, 2, c, w) X(TV, 3, c, w) X(UMBRELLA, 4, c, w) X(TV, 5, c, w) \
+	X(BALL, 6, c, w) X(INVADER, 7, c, w) X(FLAG, 8, c, w) X(INSECT, 9, c, w) X(INVADER, 10, c, w) X(INSECT, 11, c, w)
+#define BAR3(X, c, w) X(TV, 0, c, w) X(INSECT, 1, c, w) X(BALL, 2, c, w) X(GHOST, 3, c, w) X(UMBRELLA, 4, c, w) X(INVADER, 5, c, w) \
+	X(GHOST, 6, c, w) X(INSECT, 7, c, w) X(TV, 8, c, w) X(INVADER, 9, c, w) X(FLAG, 10, c, w) X(UMBRELLA, 11, c, w)
+
+#define BAR_IMAGE(image, k, c, w) image,
+
+static const uint8_t g_bar1[] PROGMEM = { BAR1(BAR_IMAGE, 0, 0) };
+static const uint8_t g_bar2[] PROGMEM = { BAR2(BAR_IMAGE, 0, 0) };
+static const uint8_t g_bar3[] PROGMEM = { BAR3(BAR_IMAGE, 0, 0) };
 
 static uint8_t g_bar1_idx = 2;
 static uint8_t g_bar2_idx = 3;
 static uint8_t g_bar3_idx = 5;
 
+typedef struct
+{
+	uint16_t const (*strip)[STRIP_WORDS];	// reel strip in program memory.
+	uint8_t x;								// display column.
+	uint8_t from_pos;						// position the spin started from.
+	uint8_t pos;							// position shown.
+	anim_t spin;
+}reel_t;
+
 // least significant bit is top.
 // images are 8 x 8 pixels.
-static const uint8_t g_tv[] = { 0xFC, 0x85, 0x86, 0x84, 0x84, 0x86, 0x85, 0xFC };
-static const uint8_t g_ghost[] = { 0xFE, 0xC1, 0x6D, 0x21, 0x21, 0x6D, 0xC1, 0xFE };
-static const uint8_t g_ball[] = { 0x28, 0x7C, 0xEE, 0x54, 0x54, 0xEE, 0x7C, 0x28 };
-static const uint8_t g_flag[] = { 0x00, 0xFF, 0x11, 0x1F, 0x3E, 0x22, 0x3E, 0x00, };
-static const uint8_t g_invader[] = { 0x58, 0xBC, 0x16, 0x3F, 0x3F, 0x16, 0xBC, 0x58 };
-static const uint8_t g_umbrella[] = { 0x18, 0x14, 0x1A, 0xFD, 0xFD, 0x9A, 0x54, 0x18 };
-static const uint8_t g_insect[] = { 0xC2, 0xE4, 0x39, 0x7E, 0x7E, 0x39, 0xE4, 0xC2 };
+#define TV_PIXELS       0xFC, 0x85, 0x86, 0x84, 0x84, 0x86, 0x85, 0xFC
+#define GHOST_PIXELS    0xFE, 0xC1, 0x6D, 0x21, 0x21, 0x6D, 0xC1, 0xFE
+#define BALL_PIXELS     0x28, 0x7C, 0xEE, 0x54, 0x54, 0xEE, 0x7C, 0x28
+#define FLAG_PIXELS     0x00, 0xFF, 0x11, 0x1F, 0x3E, 0x22, 0x3E, 0x00
+#define INVADER_PIXELS  0x58, 0xBC, 0x16, 0x3F, 0x3F, 0x16, 0xBC, 0x58
+#define UMBRELLA_PIXELS 0x18, 0x14, 0x1A, 0xFD, 0xFD, 0x9A, 0x54, 0x18
+#define INSECT_PIXELS   0xC2, 0xE4, 0x39, 0x7E, 0x7E, 0x39, 0xE4, 0xC2
+
+// column c of an image.
+#define PIXEL_COLUMN(c, ...) PIXEL_COLUMN_N(c, __VA_ARGS__)
+#define PIXEL_COLUMN_N(c, p0, p1, p2, p3, p4, p5, p6, p7) \
+	((c) == 0 ? p0 : (c) == 1 ? p1 : (c) == 2 ? p2 : (c) == 3 ? p3 : (c) == 4 ? p4 : (c) == 5 ? p5 : (c) == 6 ? p6 : p7)
+
+// an 8 pixel column placed at row d of a 16 row word (d may be negative or past the word).
+#define ROWS_AT(pixels, d) \
+	((d) >= 16 || (d) <= -8 ? 0 : \
+	 (d) >= 0 ? (uint16_t)((uint16_t)(pixels) << ((d) & 15)) : (uint16_t)((pixels) >> (-(d) & 7)))
+
+// the image at bar index k placed in word w of strip column c, the second copy covers the wrap.
+#define STRIP_SLOT(image, k, c, w) \
+	ROWS_AT(PIXEL_COLUMN(c, image##_PIXELS), (k) * (IMAGE_Y_SIZE + 1) - 16 * (w)) | \
+	ROWS_AT(PIXEL_COLUMN(c, image##_PIXELS), (k) * (IMAGE_Y_SIZE + 1) + BAR_Y_SIZE - 16 * (w)) |
+
+// the strips are written out as 8 columns of 8 words.
+#if STRIP_WORDS != 8 || IMAGE_X_SIZE != 8
+#error "STRIP_COLUMN and STRIP list 8 words and 8 columns, update them for the bar size"
+#endif
+
+#define STRIP_WORD(bar, c, w) (bar(STRIP_SLOT, c, w) 0)
+#define STRIP_COLUMN(bar, c) \
+	{ STRIP_WORD(bar, c, 0), STRIP_WORD(bar, c, 1), STRIP_WORD(bar, c, 2), STRIP_WORD(bar, c, 3), \
+	  STRIP_WORD(bar, c, 4), STRIP_WORD(bar, c, 5), STRIP_WORD(bar, c, 6), STRIP_WORD(bar, c, 7) }
+#define STRIP(bar) \
+	{ STRIP_COLUMN(bar, 0), STRIP_COLUMN(bar, 1), STRIP_COLUMN(bar, 2), STRIP_COLUMN(bar, 3), \
+	  STRIP_COLUMN(bar, 4), STRIP_COLUMN(bar, 5), STRIP_COLUMN(bar, 6), STRIP_COLUMN(bar, 7) }
+
+// bars pre-rendered as vertical strips, BAR_Y_SIZE rows (plus the wrap) by 8 columns.
+// each column is 16 bit words, the least significant bit of word 0 is the top row of the first image.
+// the bars, strips and frame are held in program memory.
+static const uint16_t g_strip1[IMAGE_X_SIZE][STRIP_WORDS] PROGMEM = STRIP(BAR1);
+static const uint16_t g_strip2[IMAGE_X_SIZE][STRIP_WORDS] PROGMEM = STRIP(BAR2);
+static const uint16_t g_strip3[IMAGE_X_SIZE][STRIP_WORDS] PROGMEM = STRIP(BAR3);
 
 // background frame.
-static const uint8_t g_frame_left[] = { 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0x80 };
-static const uint8_t g_frame_separator[] = { 0x01, 0xFF, 0x01, 0x80, 0xFF, 0x80 };
-static const uint8_t g_frame_right[] = { 0x01, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x01 };
+static const uint8_t g_frame_left[] PROGMEM = { 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0x80 };
+static const uint8_t g_frame_separator[] PROGMEM = { 0x01, 0xFF, 0x01, 0x80, 0xFF, 0x80 };
+static const uint8_t g_frame_right[] PROGMEM = { 0x01, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x01 };
+
+static reel_t g_reels[REELS] =
+{
+	{ .strip = g_strip1, .x = 9 },
+	{ .strip = g_strip2, .x = 22 },
+	{ .strip = g_strip3, .x = 35 },
+};
+
+// reel indexes to stop at and the deadline of the next spin frame.
+static uint8_t g_spin_idx[REELS];
+static uint16_t g_spin_deadline;
+static bool g_spinning = false;
+
+// scheduler task drawing the spin frames.
+static uint8_t g_frame_task = SCHED_TASKS;
 
 static uint8_t g_score = 50;
 
@@ -82,23 +168,36 @@ void draw_frame(void);
 void draw_bars(void);
 uint8_t n_indexes(uint8_t from_idx, uint8_t to_idx);
 void roll_bars(uint8_t bar1_idx, uint8_t bar2_idx, uint8_t bar3_idx);
+void roll_end(void);
+void draw_reel(reel_t * reel, uint8_t pos);
 void update_score(uint8_t img1, uint8_t img2, uint8_t img3);
 void ghosts_x3(void);
 void game_over(void);
 
-void draw_bar_at_position(uint8_t * bar, uint8_t center_pos, uint8_t const * const images);
-void draw_image(uint8_t * bar, uint8_t const * const img, uint8_t y);
-void create_rshift_image(uint8_t * img, uint8_t const * const  img_src, uint8_t shift_n);
-uint8_t prev_index(uint8_t index);
-uint8_t next_index(uint8_t index);
-uint8_t const * const image_ptr(uint8_t image_n);
+void draw_bar_at_position(uint8_t * bar, uint8_t center_pos, uint16_t const strip[][STRIP_WORDS]);
+
+// adds the slot machine task to the scheduler.
+void slot_config(void)
+{
+	g_frame_task = sched_add(slot_process, ANIM_FRAME_MS);
+}
 
 // Show the entire slot machine using it's current state.
 void slot_show()
 {
-	oled_blank();
+	vgfx_fb_clear();
 	draw_frame();
 	draw_bars();
+	vgfx_flush();
+}
+
+// stops drawing the slot machine.
+// a spin is finished at once, the reels land on their results and the score is updated,
+// so the hidden slot machine is never busy.
+void slot_hide(void)
+{
+	if (g_spinning)
+		roll_end();
 }
 
 // one play of slot machine.
@@ -108,26 +207,74 @@ void slot_action(void)
 	// generate 3 random numbers with range 0 to 11 to supply to roll_bars.
 	// temporary using literals.
 	
+	// ignored until the reels have stopped.
+	if (g_spinning)
+		return;
+
 	uint8_t idx1 = rand() % 11;
 	uint8_t idx2 = rand() % 11;
 	uint8_t idx3 = rand() % 11;
 	
 	roll_bars(idx1, idx2, idx3);
-	
-	g_bar1_idx = idx1;
-	g_bar2_idx = idx2;
-	g_bar3_idx = idx3;
+}
 
-	uint8_t img1 = g_bar1[g_bar1_idx];
-	uint8_t img2 = g_bar2[g_bar2_idx];
-	uint8_t img3 = g_bar3[g_bar3_idx];
+// draws the next frame of a spin when it is due, the score is updated when the reels stop.
+// run by the scheduler every frame period while spinning.
+void slot_process(void)
+{
+	if (!g_spinning)
+		return;
 
-	update_score(img1, img2, img3);
-	
-	if (g_score == 0)
+	uint8_t frames = anim_frames_due(&g_spin_deadline);
+
+	if (frames == 0)
+		return;
+
+	bool running = false;
+
+	for (uint8_t i = 0; i != REELS; i++)
 	{
-		game_over();
+		reel_t * reel = &g_reels[i];
+
+		if (anim_running(&reel->spin))
+		{
+			running |= anim_step(&reel->spin, frames);
+			draw_reel(reel, (reel->from_pos + anim_pixels(&reel->spin)) % BAR_Y_SIZE);
+		}
 	}
+
+	// only the reel columns that changed are written.
+	vgfx_flush();
+
+	if (!running)
+		roll_end();
+}
+
+// returns true while the reels are spinning.
+bool slot_spinning(void)
+{
+	return g_spinning;
+}
+
+// stores the reels and the score in the state kept over a power cycle.
+void slot_save(persist_state_t * state)
+{
+	state->bars[0] = g_bar1_idx;
+	state->bars[1] = g_bar2_idx;
+	state->bars[2] = g_bar3_idx;
+	state->score = g_score;
+}
+
+// restores the reels and the score at boot, before the slot machine is shown.
+void slot_restore(persist_state_t const * state)
+{
+	if (state->bars[0] >= BAR_IMAGES || state->bars[1] >= BAR_IMAGES || state->bars[2] >= BAR_IMAGES)
+		return;
+
+	g_bar1_idx = state->bars[0];
+	g_bar2_idx = state->bars[1];
+	g_bar3_idx = state->bars[2];
+	g_score = state->score;
 }
 
 uint8_t bar_pos(uint8_t index)
@@ -135,30 +282,46 @@ uint8_t bar_pos(uint8_t index)
 	return index * (IMAGE_Y_SIZE + 1) + 4;
 }
 
-// draw the slot machine frame.
+// draw the slot machine frame to the framebuffer.
 void draw_frame(void)
 {
-	vgfx_buffer_display_at(&g_frame_left[0], 7, 1);
-	vgfx_buffer_display_at(&g_frame_separator[0], 3, 18);
-	vgfx_buffer_display_at(&g_frame_separator[0], 3, 31);
-	vgfx_buffer_display_at(&g_frame_right[0], 7, 44);
+	vgfx_fb_buffer_at_P(&g_frame_left[0], 7, 1);
+	vgfx_fb_buffer_at_P(&g_frame_separator[0], 3, 18);
+	vgfx_fb_buffer_at_P(&g_frame_separator[0], 3, 31);
+	vgfx_fb_buffer_at_P(&g_frame_right[0], 7, 44);
 }
 
-// draw the bars using it's current state.
+// draw the bars to the framebuffer using it's current state.
 void draw_bars(void)
 {
-	uint8_t bar1[16] = { 0x00 };
-	uint8_t bar2[16] = { 0x00 };
-	uint8_t bar3[16] = { 0x00 };
+	if (!g_spinning)
+	{
+		g_reels[0].pos = bar_pos(g_bar1_idx);
+		g_reels[1].pos = bar_pos(g_bar2_idx);
+		g_reels[2].pos = bar_pos(g_bar3_idx);
+	}
+
+	for (uint8_t i = 0; i != REELS; i++)
+	{
+		reel_t * reel = &g_reels[i];
+		uint8_t bar[16];
+
+		draw_bar_at_position(&bar[0], reel->pos, reel->strip);
+		vgfx_fb_buffer_at(&bar[0], IMAGE_X_SIZE, reel->x);
+	}
+}
 
-	draw_bar_at_position(&bar1[0], bar_pos(g_bar1_idx), &g_bar1[0]);
-	vgfx_buffer_display_at(&bar1[0], 8, 9);
+// draws the reel to the framebuffer when its position has changed.
+void draw_reel(reel_t * reel, uint8_t pos)
+{
+	if (pos == reel->pos)
+		return;
 
-	draw_bar_at_position(&bar2[0], bar_pos(g_bar2_idx), &g_bar2[0]);
-	vgfx_buffer_display_at(&bar2[0], 8, 22);
+	uint8_t bar[16];
 
-	draw_bar_at_position(&bar3[0], bar_pos(g_bar3_idx), &g_bar3[0]);
-	vgfx_buffer_display_at(&bar3[0], 8, 35);
+	reel->pos = pos;
+	draw_bar_at_position(&bar[0], pos, reel->strip);
+	vgfx_fb_buffer_at(&bar[0], IMAGE_X_SIZE, reel->x);
 }
 
 uint8_t n_indexes(uint8_t from_idx, uint8_t to_idx)
@@ -171,65 +334,55 @@ uint8_t n_indexes(uint8_t from_idx, uint8_t to_idx)
 	return BAR_IMAGES - from_idx + to_idx;
 }
 
-// roll the bars and stop them at the given indexes.
+// starts rolling the bars to stop them at the given indexes (see slot_process).
+// the reels stop one after another, each decelerating onto its image.
 void roll_bars(uint8_t bar1_idx, uint8_t bar2_idx, uint8_t bar3_idx)
 {
-	uint8_t bar[16] = { 0x00 };
-
-	uint8_t pos1 = bar_pos(g_bar1_idx);
-	uint8_t pos2 = bar_pos(g_bar2_idx);
-	uint8_t pos3 = bar_pos(g_bar3_idx);
-
-	uint16_t steps1 = n_indexes(g_bar1_idx, bar1_idx) * (IMAGE_X_SIZE + 1);
-	uint16_t steps2 = n_indexes(g_bar2_idx, bar2_idx) * (IMAGE_X_SIZE + 1);
-	uint16_t steps3 = n_indexes(g_bar3_idx, bar3_idx) * (IMAGE_X_SIZE + 1);
-	
-	steps1 += (BAR_Y_SIZE * 2);
-	steps2 += (BAR_Y_SIZE * 2);
-	steps3 += (BAR_Y_SIZE * 2);
-
-	uint16_t max = steps1;
-	if (steps2 > max)
-		max = steps2;
-	if (steps3 > max)
-		max = steps3;
-
-	for (uint16_t i = 1; i <= max; i++)
-	{		
-		if (steps1 != 0)	
-		{
-			pos1 = pos1 == BAR_Y_SIZE-1 ? 0 : pos1 + 1;
+	uint8_t const from_idx[REELS] = { g_bar1_idx, g_bar2_idx, g_bar3_idx };
 
-			vgfx_buffer_clear(&bar[0], 16);
-			draw_bar_at_position(&bar[0], pos1, &g_bar1[0]);
-			vgfx_buffer_display_at(&bar[0], 8, 9);		
+	g_spin_idx[0] = bar1_idx;
+	g_spin_idx[1] = bar2_idx;
+	g_spin_idx[2] = bar3_idx;
 
-			steps1 --;
-		}
+	for (uint8_t i = 0; i != REELS; i++)
+	{
+		reel_t * reel = &g_reels[i];
+		uint16_t distance = n_indexes(from_idx[i], g_spin_idx[i]) * (IMAGE_Y_SIZE + 1) + (SPIN_TURNS + i) * BAR_Y_SIZE;
 
-		if (steps2 != 0)
-		{
-			pos2 = pos2 == BAR_Y_SIZE-1 ? 0 : pos2 + 1;
+		reel->from_pos = bar_pos(from_idx[i]);
+		reel->pos = reel->from_pos;
+		anim_start(&reel->spin, distance, SPIN_FRAMES + i * SPIN_STAGGER_FRAMES, SPIN_EASE_FRAMES);
+	}
 
-			vgfx_buffer_clear(&bar[0], 16);
-			draw_bar_at_position(&bar[0], pos2, &g_bar2[0]);
-			vgfx_buffer_display_at(&bar[0], 8, 22);			
+	// the reels are animated at the fast clock.
+	clock_fast();
 
-			steps2 --;
-		}
+	// the task is started after the frame clock so it is never due before the first frame.
+	anim_clock_start(&g_spin_deadline);
+	sched_start(g_frame_task, ANIM_FRAME_MS);
+	g_spinning = true;
+}
 
-		if (steps3 != 0)
-		{
-			pos3 = pos3 == BAR_Y_SIZE-1 ? 0 : pos3 + 1;
+// the reels have stopped, updates the score.
+void roll_end(void)
+{
+	g_spinning = false;
+	sched_stop(g_frame_task);
+	clock_slow();
 
-			vgfx_buffer_clear(&bar[0], 16);
-			draw_bar_at_position(&bar[0], pos3, &g_bar3[0]);
-			vgfx_buffer_display_at(&bar[0], 8, 35);
+	g_bar1_idx = g_spin_idx[0];
+	g_bar2_idx = g_spin_idx[1];
+	g_bar3_idx = g_spin_idx[2];
 
-			steps3 --;
-		}
+	uint8_t img1 = pgm_read_byte(&g_bar1[g_bar1_idx]);
+	uint8_t img2 = pgm_read_byte(&g_bar2[g_bar2_idx]);
+	uint8_t img3 = pgm_read_byte(&g_bar3[g_bar3_idx]);
 
-		//_delay_ms(5);
+	update_score(img1, img2, img3);
+	
+	if (g_score == 0)
+	{
+		game_over();
 	}
 }
 
@@ -307,100 +460,23 @@ void game_over(void)
 // example center (shown as |) = 21
 //
 
-// draws the bar containing 2 or 3 images to the buffer.
-void draw_bar_at_position(uint8_t * bar, uint8_t center_pos, uint8_t const * const images)
+// draws the 16 rows of the bar around the center position to the buffer.
+// each column of the window is one shift of the strip words, no images are composed.
+void draw_bar_at_position(uint8_t * bar, uint8_t center_pos, uint16_t const strip[][STRIP_WORDS])
 {
-	uint8_t center_img_index = center_pos / (IMAGE_Y_SIZE + 1);
-	uint8_t center_img_y = center_img_index * (IMAGE_Y_SIZE + 1) + 1;
-
-	// set center image.
-	uint8_t y = IMAGE_Y_SIZE + center_img_y - center_pos;
-	draw_image(bar, image_ptr(images[center_img_index]), y);
-
-	// set previous image.
-	if (y > 2)
-	{
-		uint8_t img_index = prev_index(center_img_index);
-		uint8_t shift_n = IMAGE_Y_SIZE + 2 - y;	
-		
-		uint8_t img[IMAGE_X_SIZE];		
-		create_rshift_image(&img[0], image_ptr(images[img_index]), shift_n);
-		draw_image(bar, &img[0], 1);
-	}
+	// first strip row shown, the center position is the 9th row down.
+	uint8_t top = center_pos >= IMAGE_Y_SIZE ? center_pos - IMAGE_Y_SIZE : center_pos + BAR_Y_SIZE - IMAGE_Y_SIZE;
+	uint8_t word = top / 16;
+	uint8_t shift_n = top % 16;
 
-	// set next image.
-	y += (IMAGE_Y_SIZE + 1);
-	if (y <= DISPLAY_Y_SIZE)
-	{
-		uint8_t img_index = next_index(center_img_index);
-		draw_image(bar, image_ptr(images[img_index]), y);
-	}
-}
-
-// returns the previous bar image index.
-uint8_t prev_index(uint8_t index)
-{
-	return index == 0 ? BAR_IMAGES - 1 : index - 1;
-}
-
-// returns the next bar image index.
-uint8_t next_index(uint8_t index)
-{
-	return index == BAR_IMAGES - 1 ? 0 : index + 1;
-}
-
-// create a right shifted copy of an image.
-void create_rshift_image(uint8_t * img, uint8_t const * const  img_src, uint8_t shift_n)
-{
 	for (uint8_t i = 0; i != IMAGE_X_SIZE; i++)
 	{
-		img[i] = img_src[i] >> shift_n;
-	}
-}
+		uint32_t rows = ((uint32_t)pgm_read_word(&strip[i][word + 1]) << 16) | pgm_read_word(&strip[i][word]);
+		uint16_t window = rows >> shift_n;
 
-// draws the image to the buffer.
-void draw_image(uint8_t * bar, uint8_t const * const img, uint8_t y)
-{
-	vgfx_buffer_or(bar, IMAGE_X_SIZE, img, IMAGE_X_SIZE, 1, y);
-}
-
-// returns pointer to image.
-uint8_t const * const image_ptr(uint8_t image_n)
-{
-	uint8_t const * addr = &g_tv[0];
-
-	switch(image_n)
-	{
-		case TV:
-			addr = &g_tv[0];
-			break;
-
-		case GHOST:
-			addr = &g_ghost[0];
-			break;
-
-		case BALL:
-			addr = &g_ball[0];
-			break;
-
-		case FLAG:
-			addr = &g_flag[0];
-			break;
-
-		case INVADER:
-			addr = &g_invader[0];
-			break;
-
-		case UMBRELLA:
-			addr = &g_umbrella[0];
-			break;
-
-		case INSECT:
-			addr = &g_insect[0];
-			break;
+		bar[i] = window;
+		bar[i + IMAGE_X_SIZE] = window >> 8;
 	}
-
-	return addr;
 }
 
 //void slot_snapshot(uint8_t * buffer)
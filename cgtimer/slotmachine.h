@@ -9,7 +9,18 @@
 #ifndef MACHINE_H_
 #define MACHINE_H_
 
+#include <stdbool.h>
+#include "persist.h"
+
+void slot_config(void);
 void slot_show(void);
+void slot_hide(void);
 void slot_action(void);
+void slot_process(void);
+bool slot_spinning(void);
+
+// state kept over a power cycle (see persist.h).
+void slot_save(persist_state_t * state);
+void slot_restore(persist_state_t const * state);
 
 #endif /* MACHINE_H_ */
@@ -0,0 +1,77 @@
+/*
+ * tick.c
+ *
+ */ 
+
+#ifndef F_CPU				// if F_CPU was not defined in Project -> Properties
+#define F_CPU 1000000UL		// define it now as 1 MHz unsigned long
+#endif
+
+#include "tick.h"
+#include "buttons.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+// timer0 prescaler, the timer counts at 125 kHz.
+#if F_CPU >= 8000000UL
+#define TICK_PRESCALER 64
+#define TICK_CS ((1 << CS01) | (1 << CS00))
+#else
+#define TICK_PRESCALER 8
+#define TICK_CS (1 << CS01)
+#endif
+
+// timer0 clock select at the fast clock (see clock.h), still 125 kHz.
+#define TICK_CS_FAST ((1 << CS01) | (1 << CS00))
+
+// timer0 counts per millisecond.
+#define TICK_COUNTER_VALUE (F_CPU / TICK_PRESCALER / 1000 - 1)
+
+// milliseconds, written by the timer0 interrupt.
+static volatile uint16_t g_tick_ms = 0;
+
+
+// configures timer0 to interrupt every millisecond.
+void tick_config(void)
+{
+	// CTC (clear timer on compare) mode, the counter restarts at OCR0A.
+	TCCR0A = (1 << WGM01);
+	OCR0A = TICK_COUNTER_VALUE;
+	TCCR0B = TICK_CS;
+
+	TIMSK0 |= (1 << OCIE0A);
+}
+
+// switches the timer0 prescaler with the system clock (see clock.h).
+void tick_clock(bool fast)
+{
+	TCCR0B = fast ? TICK_CS_FAST : TICK_CS;
+}
+
+// Interrupt service routine.
+// When timer0 comparison routine matches the value.
+// the buttons are sampled from here.
+ISR(TIMER0_COMPA_vect)
+{
+	g_tick_ms++;
+
+	buttons_tick();
+}
+
+// returns the milliseconds counted since tick_config().
+uint16_t tick_now(void)
+{
+	// the 16 bit count is read with the tick interrupt held off.
+	uint8_t sreg = SREG;
+	cli();
+	uint16_t ms = g_tick_ms;
+	SREG = sreg;
+
+	return ms;
+}
+
+// returns true once the tick count has reached the deadline.
+bool tick_reached(uint16_t deadline)
+{
+	return (int16_t)(tick_now() - deadline) >= 0;
+}
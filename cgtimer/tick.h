@@ -0,0 +1,31 @@
+/*
+ * tick.h
+ *
+ * Millisecond system tick from timer0.
+ *
+ * The tick count is 16 bits and wraps about every 65 seconds.
+ * Deadlines are compared with tick_reached() which allows for the wrap,
+ * so a deadline must be less than 32 seconds away.
+ *
+ */ 
+
+
+#ifndef TICK_H_
+#define TICK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// configures timer0 to interrupt every millisecond.
+void tick_config(void);
+
+// switches the timer0 prescaler with the system clock (see clock.h).
+void tick_clock(bool fast);
+
+// returns the milliseconds counted since tick_config().
+uint16_t tick_now(void);
+
+// returns true once the tick count has reached the deadline.
+bool tick_reached(uint16_t deadline);
+
+#endif /* TICK_H_ */
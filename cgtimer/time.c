@@ -8,53 +8,54 @@
 #include "time.h"
 
 // convert a number of seconds to a time structure.
-time_t seconds_to_time(uint16_t seconds)
+time_t seconds_to_time(uint32_t seconds)
 {
 	time_t t = {0,0,0};
-	
-	if (seconds >= 3600)
-	{
-		uint16_t n = seconds / 3600;
-		t.hours = (uint8_t)(n);
-		seconds -= n * 3600;
-	}
 
-	if (seconds >= 60)
-	{
-		uint16_t n = seconds / 60;
-		t.mins = (uint8_t)(n);
-		seconds -= n * 60;
-	}
-
-	t.secs = (uint8_t)seconds;
+	t.secs = divide_u8(&seconds, 60);
+	t.mins = divide_u8(&seconds, 60);
+	t.hours = seconds;
 
 	return t;
 }
 
-// convert a number of seconds to a base 10 structure.
-secs_base10_t seconds_to_base10(uint16_t seconds)
+// convert a number of seconds to a base 10 structure, the lowest six digits.
+secs_base10_t seconds_to_base10(uint32_t seconds)
 {
-	secs_base10_t secs = { 0, 0, 0, 0, 0 };
-	
-	if (seconds >= 10000)
-	{
-		secs.ten_thousands = seconds / 10000;
-		seconds -= (secs.ten_thousands * 10000);
-	}
+	secs_base10_t secs = { 0, 0, 0, 0, 0, 0 };
 
-	if (seconds >= 1000)
+	secs.units = divide_u8(&seconds, 10);
+	secs.tens = divide_u8(&seconds, 10);
+	secs.hundreds = divide_u8(&seconds, 10);
+	secs.thousands = divide_u8(&seconds, 10);
+	secs.ten_thousands = divide_u8(&seconds, 10);
+	secs.hundred_thousands = divide_u8(&seconds, 10);
+
+	return secs;
+}
+
+// divides n by a divisor of at most 128 in place, returning the remainder.
+// the AVR has no divider, this is a 32 step shift and subtract with an 8 bit remainder
+// rather than the 32 bit library division.
+uint8_t divide_u8(uint32_t * n, uint8_t divisor)
+{
+	uint32_t quotient = *n;
+	uint8_t remainder = 0;
+
+	for (uint8_t i = 0; i != 32; i++)
 	{
-		secs.thousands = seconds / 1000;
-		seconds -= (secs.thousands * 1000);
+		// the remainder is below the divisor, so shifted it still fits 8 bits.
+		remainder = (remainder << 1) | (uint8_t)(quotient >> 31);
+		quotient <<= 1;
+
+		if (remainder >= divisor)
+		{
+			remainder -= divisor;
+			quotient |= 1;
+		}
 	}
-	
-	secs.hundreds = seconds / 100;
-	seconds -= (secs.hundreds * 100);
 
-	secs.tens = seconds / 10;
-	seconds -= (secs.tens * 10);
+	*n = quotient;
 
-	secs.units = seconds;
-	
-	return secs;
+	return remainder;
 }
@@ -13,15 +13,16 @@
 // time structure (hrs, mins, seconds)
 typedef struct 
 {
-	uint8_t hours;
+	uint32_t hours;
 	uint8_t mins;
 	uint8_t secs;
 	
 }time_t;
 
-// seconds in base 10 structure (thousands, hundreds, tens, units)
+// seconds in base 10 structure (hundred thousands, ten thousands, thousands, hundreds, tens, units)
 typedef struct
 {
+	uint8_t hundred_thousands;
 	uint8_t ten_thousands;
 	uint8_t thousands;
 	uint8_t hundreds;
@@ -31,9 +32,12 @@ typedef struct
 
 
 // convert a number of seconds to a time structure.
-time_t seconds_to_time(uint16_t seconds);
+time_t seconds_to_time(uint32_t seconds);
 
-// convert a number of seconds to a base 10 structure.
-secs_base10_t seconds_to_base10(uint16_t seconds);
+// convert a number of seconds to a base 10 structure, the lowest six digits.
+secs_base10_t seconds_to_base10(uint32_t seconds);
+
+// divides n by a divisor of at most 128 in place, returning the remainder.
+uint8_t divide_u8(uint32_t * n, uint8_t divisor);
 
 #endif /* TIME_H_ */
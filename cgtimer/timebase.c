@@ -0,0 +1,330 @@
+/*
+ * timebase.c
+ *
+ */ 
+
+#ifndef F_CPU				// if F_CPU was not defined in Project -> Properties
+#define F_CPU 1000000UL		// define it now as 1 MHz unsigned long
+#endif
+
+#include "timebase.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "time.h"
+
+// timer1 prescaler, the timer counts at 125 kHz.
+#if F_CPU >= 8000000UL
+#define TIMEBASE_PRESCALER 64
+#define TIMEBASE_CS ((1 << CS11) | (1 << CS10))
+#else
+#define TIMEBASE_PRESCALER 8
+#define TIMEBASE_CS (1 << CS11)
+#endif
+
+// timer1 clock select at the fast clock (see clock.h), still 125 kHz.
+#define TIMEBASE_CS_FAST ((1 << CS11) | (1 << CS10))
+
+// interrupts per second.
+#define INTERVALS 2
+
+// counts per interval as 16.16 fixed point, exact for any F_CPU.
+#define PERIOD_Q16 ((uint32_t)(((uint64_t)F_CPU << 16) / (TIMEBASE_PRESCALER * INTERVALS)))
+
+#if F_CPU / (TIMEBASE_PRESCALER * INTERVALS) >= 65536
+#error "timer1 interval does not fit 16 bits, increase TIMEBASE_PRESCALER"
+#endif
+
+// interval length, whole counts and the fraction (1/65536 counts) added each interval.
+static uint16_t g_period = PERIOD_Q16 >> 16;
+static uint16_t g_period_frac = (uint16_t)PERIOD_Q16;
+static uint16_t g_frac_acc = 0;
+static int16_t g_trim_ppm = 0;
+
+// digit radixes, units first.
+static const uint8_t g_time_radix[TIMEBASE_TIME_DIGITS] = { 10, 6, 10, 6, 10, 10, 10 };
+static const uint8_t g_decimal_radix[TIMEBASE_DECIMAL_DIGITS] = { 10, 10, 10, 10, 10, 10 };
+
+// written by the interrupt, which adds 1 to the sequence after each update.
+// the main loop reads without holding the interrupt off, retrying when the sequence changes.
+static volatile uint8_t g_seq = 0;
+static volatile uint32_t g_secs = 0;
+static volatile uint8_t g_half = 0;
+static volatile bool g_run = false;
+
+// the seconds as digit counters, with the digits changed since the reader's last copy.
+// the reader acknowledges a copy with its sequence, the interrupt then starts the changes again.
+static volatile uint8_t g_time[TIMEBASE_TIME_DIGITS];
+static volatile uint8_t g_time_changed = 0;
+static volatile uint8_t g_time_ack = 0;
+static volatile uint8_t g_decimal[TIMEBASE_DECIMAL_DIGITS];
+static volatile uint8_t g_decimal_changed = 0;
+static volatile uint8_t g_decimal_ack = 0;
+
+// function declarations.
+uint8_t count_digits(uint8_t * digits, uint8_t const * radix, uint8_t n);
+uint8_t copy_digits(uint8_t * digits, uint8_t const volatile * counter, uint8_t n, uint8_t volatile * changed, uint8_t volatile * ack);
+
+
+// configures timer1 to interrupt every half second.
+void timebase_config(void)
+{
+	timebase_trim(TIMEBASE_TRIM_PPM);
+
+	// timer counter configuration register for timer1.
+	TCCR1A = 0x00;
+
+	// Using CTC (clear timer on compare) mode.
+	//
+	// At each clock tick it will compare the value of the timer's counter to the OCR1A register.
+	// if it matches it's going to clear the counter and provide an interrupt.
+	// The counter counts from 0 to OCR1A, so an interval is OCR1A + 1 counts.
+	OCR1A = g_period - 1;
+	TCCR1B = (1 << WGM12) | TIMEBASE_CS;
+
+	// Tell the timer I want an interrupt.
+	TIMSK1 |= (1 << OCIE1A);
+}
+
+// switches the timer1 prescaler with the system clock (see clock.h).
+void timebase_clock(bool fast)
+{
+	TCCR1B = (1 << WGM12) | (fast ? TIMEBASE_CS_FAST : TIMEBASE_CS);
+}
+
+// sets the oscillator trim, the measured clock error in parts per million (positive when fast).
+void timebase_trim(int16_t ppm)
+{
+	// counts per interval scaled by (1 + ppm / 1000000).
+	// (PERIOD_Q16 >> 6) / 15625 is PERIOD_Q16 / 1000000 without overflowing.
+	uint32_t period = PERIOD_Q16 + (int32_t)((PERIOD_Q16 >> 6) / 15625) * ppm;
+
+	uint8_t sreg = SREG;
+	cli();
+	g_period = period >> 16;
+	g_period_frac = (uint16_t)period;
+	g_trim_ppm = ppm;
+	SREG = sreg;
+}
+
+// returns the oscillator trim.
+int16_t timebase_get_trim(void)
+{
+	return g_trim_ppm;
+}
+
+// Interrupt service routine.
+// When timer1 comparison routine matches the value.
+ISR(TIMER1_COMPA_vect)
+{
+	// the next interval is one count longer each time the fraction carries.
+	uint16_t acc = g_frac_acc + g_period_frac;
+	OCR1A = g_period - 1 + (acc < g_frac_acc);
+	g_frac_acc = acc;
+
+	// the changes the reader has copied since the last update are dropped.
+	uint8_t seq = g_seq;
+
+	if (g_time_ack == seq)
+		g_time_changed = 0;
+
+	if (g_decimal_ack == seq)
+		g_decimal_changed = 0;
+
+	if (g_half == 0)
+	{
+		// half a second.
+		g_half = 1;
+	}
+	else
+	{
+		// second.
+		g_half = 0;
+
+		if (g_run)
+		{
+			g_secs++;
+
+			// the interrupt has the counters to itself, the casts drop the volatile.
+			g_time_changed |= count_digits((uint8_t *)g_time, g_time_radix, TIMEBASE_TIME_DIGITS);
+			g_decimal_changed |= count_digits((uint8_t *)g_decimal, g_decimal_radix, TIMEBASE_DECIMAL_DIGITS);
+		}
+	}
+
+	g_seq++;
+}
+
+// starts or stops counting seconds, starting restarts the half second.
+void timebase_run(bool run)
+{
+	uint8_t sreg = SREG;
+	cli();
+
+	if (run && !g_run)
+	{
+		// a compare match latched while stopped would cut the first half second short.
+		TCNT1 = 0;
+		TIFR1 = (1 << OCF1A);
+		g_half = 0;
+	}
+
+	g_run = run;
+	g_seq++;
+	SREG = sreg;
+}
+
+// clears the seconds counted.
+void timebase_clear(void)
+{
+	timebase_set(0);
+}
+
+// sets the seconds counted, the digit counters hold at their largest values.
+// the main loop writes with the interrupt held off, the sequence tells readers the state changed.
+void timebase_set(uint32_t secs)
+{
+	// the digits are worked out before the interrupt is held off.
+	time_t t = seconds_to_time(secs);
+
+	if (t.hours > 999)
+	{
+		t.hours = 999;
+		t.mins = 59;
+		t.secs = 59;
+	}
+
+	secs_base10_t hours = seconds_to_base10(t.hours);
+	secs_base10_t decimal = seconds_to_base10((secs > 999999) ? 999999 : secs);
+
+	uint8_t const time[TIMEBASE_TIME_DIGITS] = { t.secs % 10, t.secs / 10, t.mins % 10, t.mins / 10, hours.units, hours.tens, hours.hundreds };
+	uint8_t const digits[TIMEBASE_DECIMAL_DIGITS] = { decimal.units, decimal.tens, decimal.hundreds, decimal.thousands, decimal.ten_thousands, decimal.hundred_thousands };
+
+	uint8_t sreg = SREG;
+	cli();
+
+	g_secs = secs;
+
+	for (uint8_t i = 0; i != TIMEBASE_TIME_DIGITS; i++)
+	{
+		g_time[i] = time[i];
+	}
+
+	for (uint8_t i = 0; i != TIMEBASE_DECIMAL_DIGITS; i++)
+	{
+		g_decimal[i] = digits[i];
+	}
+
+	g_time_changed = (1 << TIMEBASE_TIME_DIGITS) - 1;
+	g_decimal_changed = (1 << TIMEBASE_DECIMAL_DIGITS) - 1;
+	g_seq++;
+
+	SREG = sreg;
+}
+
+// returns a consistent snapshot of the count.
+void timebase_snapshot(timebase_snapshot_t * snapshot)
+{
+	uint8_t seq;
+
+	do
+	{
+		seq = g_seq;
+
+		snapshot->secs = g_secs;
+		snapshot->half = g_half;
+		snapshot->count = TCNT1;
+		snapshot->running = g_run;
+	}
+	while (seq != g_seq);
+}
+
+// returns the seconds counted.
+uint32_t timebase_secs(void)
+{
+	timebase_snapshot_t snapshot;
+	timebase_snapshot(&snapshot);
+
+	return snapshot.secs;
+}
+
+// returns the hundredths of a second counted, only while counting.
+// counting starts with the half second, so the half seconds are twice the seconds plus the half.
+uint32_t timebase_centisecs(void)
+{
+	timebase_snapshot_t snapshot;
+	timebase_snapshot(&snapshot);
+
+	uint32_t halves = snapshot.secs * 2 + snapshot.half;
+
+	return halves * (100 / INTERVALS) + (uint32_t)snapshot.count * (100 / INTERVALS) / g_period;
+}
+
+// copies the time digits, returning a bit for each digit changed since the last call.
+uint8_t timebase_time_digits(uint8_t * digits)
+{
+	return copy_digits(digits, g_time, TIMEBASE_TIME_DIGITS, &g_time_changed, &g_time_ack);
+}
+
+// copies the decimal digits, returning a bit for each digit changed since the last call.
+uint8_t timebase_decimal_digits(uint8_t * digits)
+{
+	return copy_digits(digits, g_decimal, TIMEBASE_DECIMAL_DIGITS, &g_decimal_changed, &g_decimal_ack);
+}
+
+// returns the half second, 0 for the first half of a second and 1 for the second.
+uint8_t timebase_half(void)
+{
+	return g_half;
+}
+
+// adds a second to a digit counter, carrying up through the digits.
+// returns a bit for each digit changed, the counter holds at its largest value.
+uint8_t count_digits(uint8_t * digits, uint8_t const * radix, uint8_t n)
+{
+	uint8_t changed = 0;
+
+	for (uint8_t i = 0; i != n; i++)
+	{
+		changed |= (1 << i);
+
+		if (++digits[i] != radix[i])
+		{
+			return changed;
+		}
+
+		digits[i] = 0;
+	}
+
+	// it overflowed, every digit was at its largest and stays there.
+	for (uint8_t i = 0; i != n; i++)
+	{
+		digits[i] = radix[i] - 1;
+	}
+
+	return 0;
+}
+
+// copies a digit counter and its changed digits, acknowledging the changes.
+// an update during the copy starts it again, an update after it is before the acknowledgement
+// so its changes are kept along with those copied (they are drawn again).
+uint8_t copy_digits(uint8_t * digits, uint8_t const volatile * counter, uint8_t n, uint8_t volatile * changed, uint8_t volatile * ack)
+{
+	uint8_t seq;
+	uint8_t result;
+
+	do
+	{
+		seq = g_seq;
+
+		for (uint8_t i = 0; i != n; i++)
+		{
+			digits[i] = counter[i];
+		}
+
+		result = *changed;
+	}
+	while (seq != g_seq);
+
+	*ack = seq;
+
+	return result;
+}
@@ -0,0 +1,92 @@
+/*
+ * timebase.h
+ *
+ * Half second timebase from timer1, counting the stopwatch seconds.
+ *
+ * Timer1 counts at TIMEBASE_HZ. A half second is rarely a whole number of counts
+ * (and never is once trimmed), so the period is held as a whole count and a 16 bit fraction.
+ * Each interrupt adds the fraction to an accumulator and the interval that carries is one count
+ * longer, so over time the average interval is exact (Bresenham style).
+ *
+ * The trim corrects the oscillator, the internal RC oscillator is only accurate to a few percent.
+ * It is the measured clock error in parts per million, positive when the clock runs fast.
+ *
+ * Alongside the binary count the interrupt keeps the seconds as digit counters, the time
+ * (mixed radix, up to 999:59:59) and decimal seconds (up to 999999), so they are drawn without
+ * any division. Each counter records which of its digits changed since it was last read.
+ *
+ * The main loop reads the state the interrupt writes without holding the interrupt off.
+ * The interrupt adds 1 to a sequence number after each update, a reader copies the state
+ * and starts again if the sequence changed meanwhile. Timer interrupts are never delayed
+ * by a reader, and any state read as a whole should be read this way.
+ *
+ */ 
+
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// default oscillator trim (build-time option), see timebase_trim().
+// a trim stored with the state kept over a power cycle replaces it at boot (see persist.h).
+#ifndef TIMEBASE_TRIM_PPM
+#define TIMEBASE_TRIM_PPM 0
+#endif
+
+// time digits, units first: secs, tens of secs, mins, tens of mins, hours, tens and hundreds of hours.
+#define TIMEBASE_TIME_DIGITS 7
+
+// decimal digits of the seconds, units first.
+#define TIMEBASE_DECIMAL_DIGITS 6
+
+// a consistent snapshot of the count.
+typedef struct
+{
+	uint32_t secs;		// seconds counted.
+	uint8_t half;		// 0 for the first half of a second and 1 for the second.
+	uint16_t count;		// timer1 count into the half second.
+	bool running;		// counting seconds.
+}timebase_snapshot_t;
+
+// configures timer1 to interrupt every half second.
+void timebase_config(void);
+
+// switches the timer1 prescaler with the system clock (see clock.h).
+void timebase_clock(bool fast);
+
+// sets the oscillator trim, the measured clock error in parts per million (positive when fast).
+void timebase_trim(int16_t ppm);
+
+// returns the oscillator trim.
+int16_t timebase_get_trim(void);
+
+// clears the seconds counted.
+void timebase_clear(void);
+
+// sets the seconds counted.
+void timebase_set(uint32_t secs);
+
+// starts or stops counting seconds, starting restarts the half second.
+void timebase_run(bool run);
+
+// returns a consistent snapshot of the count.
+void timebase_snapshot(timebase_snapshot_t * snapshot);
+
+// returns the seconds counted.
+uint32_t timebase_secs(void);
+
+// copies the time digits, returning a bit for each digit changed since the last call.
+uint8_t timebase_time_digits(uint8_t * digits);
+
+// copies the decimal digits, returning a bit for each digit changed since the last call.
+uint8_t timebase_decimal_digits(uint8_t * digits);
+
+// returns the hundredths of a second counted, only while counting.
+uint32_t timebase_centisecs(void);
+
+// returns the half second, 0 for the first half of a second and 1 for the second.
+uint8_t timebase_half(void);
+
+#endif /* TIMEBASE_H_ */
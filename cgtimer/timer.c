@@ -7,156 +7,189 @@
 
 #include "timer.h"
 #include <stdint.h>
+#include <string.h>
 #include <avr/interrupt.h>
-#include "time.h"
-#include "gfx.h"
+#include <avr/pgmspace.h>
+#include "vgfx.h"
 #include "cgoled.h"
+#include "font5x8.h"
 #include "numeric5x8.h"
-//#include "vgfx.h"
+#include "timebase.h"
+#include "tick.h"
+#include "laps.h"
+#include "time.h"
 
 // timer modes.
-#define MODE_SLEEP 0
 #define MODE_IDLE 1
 #define MODE_COUNT 2
 
 #define MODE_DISPLAY_TIME 0
 #define MODE_DISPLAY_NUMBER 1
+#define MODE_DISPLAY_LAPS 2
+
+// the time display is drawn in character mode, a character each digit (build-time option).
+// 0 draws it in graphics mode like the other displays.
+#ifndef TIMER_CHARACTERS
+#define TIMER_CHARACTERS 1
+#endif
+
+// most hour digits that fit the character row (hh:mm:ss), longer times are drawn in graphics mode.
+#define CHAR_HOUR_DIGITS 2
+
+// character rows of the time and the blank row.
+#define CHAR_ROW 1
+#define CHAR_BLANK_ROW 2
+
+// user defined character (1 to 8) of the separator and its character code.
+#define CHAR_SEPARATOR 1
+#define CHAR_SEPARATOR_CODE (CHAR_SEPARATOR - 1)
+
+// changed digits mask to redraw every digit.
+#define DIGITS_ALL 0xFF
+
+// columns taken by a time separator and the space after it.
+#define SEPARATOR_ADVANCE 2
+
+// x of the mins in the mm:ss layout.
+#define TIME_MINS_X 21
+
+// x of the lap number and split in a lap review row.
+#define LAP_NUMBER_X 1
+#define LAP_SPLIT_X 17
+
+// lap review rows shown, one to each page.
+#define LAP_ROWS 2
+
+// longest split shown in a lap review row (9:59:59), in seconds.
+#define LAP_SPLIT_MAX 35999UL
+
+// x of the units and thousands of the number layout.
+#define NUMBER_UNITS_X 41
+#define NUMBER_THOUSANDS_X 20
 
-// timer1
-// 10 bits ... 1024 (1 second)
-// 11 bits ...      (1/2 second)
-// 1 MHz clock
-// counter values is roughly the number of timer ticks in half a second.
-#define PRESCALER 11
-#define CLOCK_RATE 1000000
-#define COUNTER_VALUE (CLOCK_RATE >> PRESCALER)
+// characters 8x5 (5 columns) pixels, held in program memory.
+// they are split into the two display pages at the digit baseline (see numeric5x8.h).
+static const uint8_t g_space[] PROGMEM = { 0x00, 0x00, 0x00, 0x00, 0x00 };
+static const uint8_t g_comma[] PROGMEM = { DIGIT5X8_UPPER(0x80), DIGIT5X8_UPPER(0x40), DIGIT5X8_LOWER(0x80), DIGIT5X8_LOWER(0x40) };
+static const uint8_t g_separator[] PROGMEM = { DIGIT5X8_UPPER(0x22), DIGIT5X8_LOWER(0x22) };
 
-// characters 8x5 (5 columns) pixels.
-static const uint8_t g_space[] = { 0x00, 0x00, 0x00, 0x00, 0x00 };
-static const uint8_t g_comma[] = { 0x80, 0x40 };
+// separator for character mode, the dots of g_separator in the middle column (CGRAM rows).
+static const uint8_t g_char_separator[8] PROGMEM = { 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00 };
+
+// narrow marks for the lap review rows, 8 pixel rows.
+static const uint8_t g_row_colon[] PROGMEM = { 0x22 };
+static const uint8_t g_row_point[] PROGMEM = { 0x40 };
+static const char g_no_laps[] PROGMEM = "no laps";
 
 // global mode.
 static uint8_t g_mode = MODE_IDLE;
 static uint8_t g_display = MODE_DISPLAY_TIME;
 
-// globals set by the timer.
-static uint16_t g_timer_secs = 0;
-static uint16_t g_timer_idle_secs = 0;
-static uint8_t g_timer_interval = 0;
+// hour digits in the time layout drawn, 0 for mm:ss.
+static uint8_t g_hour_digits = 0;
+
+// significant digits in the number layout drawn, at least 3.
+static uint8_t g_number_digits = 3;
+
+// x of the blinking separator between the mins and secs.
+static uint8_t g_separator_x = TIME_MINS_X + 2 * FONT5X8_ADVANCE;
+
+// lap shown on the top row of the lap review.
+static uint16_t g_review_lap = 1;
+
+// the display is in character mode showing the time, the framebuffer is not flushed.
+static bool g_characters = false;
+
+// the separator is loaded into CGRAM, it is kept while the display is in graphics mode.
+static bool g_char_loaded = false;
+
+// column of the blinking separator in character mode.
+static uint8_t g_char_separator_column = 1;
 
 // function declarations.
-void sleep(void);
-void wake(void);
 void timer_start(void);
 void timer_stop(void);
-void timer_clear(void);
-void display_time(uint16_t seconds);
+uint8_t display_count(bool all);
+void display_time(uint8_t const * digits, uint8_t changed);
 void display_time_separator(void);
-void display_number(uint16_t seconds);
+void display_number(uint8_t const * digits, uint8_t changed);
 void clear_time_separator(void);
+void display_paged(uint8_t x, uint8_t const * const image, uint8_t columns);
+void display_flush(void);
+void characters_begin(void);
+void characters_end(void);
+void character_time(uint8_t const * digits, uint8_t changed, uint8_t hour_digits);
+void display_laps(void);
+void display_lap_row(uint8_t y, uint16_t lap);
+void display_row_text(uint8_t x, uint8_t y, char const * text);
+uint16_t review_newest(void);
 
 void timer_config(void)
 {
-	// output compare register for timer1.
-	OCR1A = COUNTER_VALUE;
-
-	// timer counter configuration register for timer1.
-	TCCR1A = 0x00;
-
-	// Using CTC (clear timer on compare) mode.
-	//
-	// At each clock tick it will compare the value of the timer's counter to the OCR1A register.
-	// if it matches it's going to clear the counter and provide an interrupt.
-	TCCR1B |= (1 << WGM12);
-
-	// Set the prescaler to a value of 1024.
-	// Will divide the clock by a value of 1024.
-	// The 1MHz clock becomes about 1Khz.
-	TCCR1B |= (1 << CS10) | (1 << CS12);
-
-	// Tell the timer I want an interrupt.
-	TIMSK1 |= (1 << OCIE1A);
+	// the seconds are counted by timer1.
+	timebase_config();
 
 	// globally enable interrupts.
 	sei();
 }
 
-// Interrupt service routine.
-// When timer1 comparison routine matches the value.
-ISR(TIMER1_COMPA_vect)
+void timer_show(void)
 {
-	if (g_timer_interval == 0)
-	{
-		// half a second.
-		g_timer_interval = 1;
-	}
+	vgfx_fb_clear();
+
+	if (g_display == MODE_DISPLAY_LAPS)
+		display_laps();
 	else
-	{
-		// second.
-		g_timer_interval = 0;
+		display_count(true);
 
-		if (g_mode == MODE_IDLE)
-		{
-			g_timer_idle_secs++;
-		}
-		else if (g_mode == MODE_COUNT)
-		{
-			g_timer_secs++;
-		}
-	}
+	display_flush();
 }
 
-void timer_show(void)
+// leaves character mode for the application shown next, the timer keeps counting.
+void timer_hide(void)
 {
-	oled_blank();
-	
-	uint16_t timer_secs = g_timer_secs;
-	
-	if (g_display == MODE_DISPLAY_TIME)
-	{
-		display_time(timer_secs);
-	}
-	else
-	{
-		display_number(timer_secs);	
-	}
+	characters_end();
 }
 
 
 void timer_process(void)
 {
-	static uint16_t timer_secs = 0;
 	static uint8_t timer_interval = 0;
 	
 	// display the time
 	if (g_mode == MODE_COUNT)
 	{
-		if (timer_secs != g_timer_secs)
+		uint8_t interval = timebase_half();
+
+		if (display_count(false))
 		{
-			timer_secs = g_timer_secs;
-			timer_interval = g_timer_interval;
-				
-			if (g_display == MODE_DISPLAY_TIME)
-				display_time(timer_secs);
-			else
-				display_number(timer_secs);
-				
+			timer_interval = interval;
+			display_flush();
 		}
-		else if (timer_interval != g_timer_interval)
+		else if (timer_interval != interval)
 		{
-			timer_interval = g_timer_interval;
+			timer_interval = interval;
 				
 			if (g_display == MODE_DISPLAY_TIME)
+			{
 				clear_time_separator();
+				display_flush();
+			}
 		}		
 	}	
 }
 
 void timer_action(void)
 {
-	if (g_mode == MODE_SLEEP)
+	if (g_display == MODE_DISPLAY_LAPS)
 	{
-		wake();
+		// the lap review scrolls back through the laps, from the oldest to the newest again.
+		if (g_review_lap > laps_oldest())
+			g_review_lap--;
+		else
+			g_review_lap = review_newest();
+
+		timer_show();
 	}
 	else if (g_mode == MODE_IDLE)
 	{
@@ -168,12 +201,45 @@ void timer_action(void)
 	}
 }
 
+// returns true while the timer is counting, the MCU must not power down.
+bool timer_counting(void)
+{
+	return g_mode == MODE_COUNT;
+}
+
+// stores the seconds counted, the oscillator trim and the display in the state kept over a power cycle.
+void timer_save(persist_state_t * state)
+{
+	state->timer_secs = timebase_secs();
+	state->timer_trim = timebase_get_trim();
+	state->timer_display = g_display;
+}
+
+// restores the seconds counted, the oscillator trim and the display at boot, before the timer is shown.
+// the count is restored stopped, the lap review (the laps are not kept) opens as the time.
+void timer_restore(persist_state_t const * state)
+{
+	timebase_set(state->timer_secs);
+	timebase_trim(state->timer_trim);
+
+	if (state->timer_display == MODE_DISPLAY_NUMBER)
+		g_display = MODE_DISPLAY_NUMBER;
+	else
+		g_display = MODE_DISPLAY_TIME;
+}
+
 void timer_switch(void)
 {
 	if (g_display == MODE_DISPLAY_TIME)
 	{
 		g_display = MODE_DISPLAY_NUMBER;
 	}	
+	else if (g_display == MODE_DISPLAY_NUMBER)
+	{
+		// the lap review starts with the newest laps.
+		g_display = MODE_DISPLAY_LAPS;
+		g_review_lap = review_newest();
+	}
 	else
 	{
 		g_display = MODE_DISPLAY_TIME;
@@ -182,6 +248,28 @@ void timer_switch(void)
 	timer_show();
 }
 
+// records a lap while counting, otherwise switches between the displays.
+void timer_alt_action(uint16_t pressed_ms)
+{
+	if (g_mode == MODE_COUNT)
+		timer_lap(pressed_ms);
+	else
+		timer_switch();
+}
+
+// records a lap while counting, pressed_ms is the tick time the lap button was pressed (see tick.h).
+// the lap is timed from when the press was detected, not when it was handled.
+void timer_lap(uint16_t pressed_ms)
+{
+	if (g_mode != MODE_COUNT)
+		return;
+
+	uint32_t centisecs = timebase_centisecs();
+	uint16_t latency = (uint16_t)(tick_now() - pressed_ms) / 10;
+
+	laps_record(centisecs > latency ? centisecs - latency : 0);
+}
+
 
 //void timer_snapshot(uint8_t * buffer)
 //{
@@ -195,91 +283,376 @@ void timer_switch(void)
 	//vgfx_buffer_or(buffer, 50, 2, digit_ptr(t.secs % 10), 5, 33, 6);
 //}
 
-void sleep(void)
+// starts counting, carrying on from the count so far.
+void timer_start(void)
 {
-	// globally disable interrupts.
-	cli();
-
-	g_mode = MODE_SLEEP;
-	timer_clear();
-	oled_power_off();
+	g_mode = MODE_COUNT;
+	timebase_run(true);
 }
 
-void wake(void)
+// stops counting and clears the count and the laps.
+void timer_reset(void)
 {
 	g_mode = MODE_IDLE;
-	timer_clear();
-	oled_power_on();
+	timebase_run(false);
+	timebase_clear();
+	laps_clear();
 
-	// globally enable interrupts.
-	sei();
-}
-
-void timer_start(void)
-{
-	g_mode = MODE_COUNT;
-	timer_clear();
+	g_review_lap = review_newest();
+	timer_show();
 }
 
 void timer_stop(void)
 {
 	g_mode = MODE_IDLE;
-	timer_clear();
+	timebase_run(false);
 	
 	if (g_display == MODE_DISPLAY_TIME)
+	{
 		display_time_separator();
+		display_flush();
+	}
 }
 
-void timer_clear(void)
+// draws the digits of the count changed since the last draw, or all of them.
+// returns the changed digits.
+uint8_t display_count(bool all)
 {
-	g_timer_interval = 0;
-	g_timer_idle_secs = 0;
+	uint8_t digits[TIMEBASE_TIME_DIGITS];
+	uint8_t changed;
+
+	if (g_display == MODE_DISPLAY_TIME)
+	{
+		changed = timebase_time_digits(digits);
+
+		if (all)
+			changed = DIGITS_ALL;
+
+		if (changed)
+			display_time(digits, changed);
+	}
+	else
+	{
+		changed = timebase_decimal_digits(digits);
+
+		if (all)
+			changed = DIGITS_ALL;
+
+		if (changed)
+			display_number(digits, changed);
+	}
+
+	return changed;
 }
 
-// displays the time vertical centered. (16 pixels in Y axis).
-void display_time(uint16_t seconds)
+// draws the changed time digits vertical centered to the framebuffer. (16 pixels in Y axis).
+// mm:ss below an hour, then h:mm:ss centered with up to three hour digits.
+void display_time(uint8_t const * digits, uint8_t changed)
 {
-	time_t t = seconds_to_time(seconds);
+	uint8_t hour_digits = digits[6] ? 3 : digits[5] ? 2 : digits[4] ? 1 : 0;
+
+#if TIMER_CHARACTERS
+	if (hour_digits <= CHAR_HOUR_DIGITS)
+	{
+		characters_begin();
+		character_time(digits, changed, hour_digits);
+		return;
+	}
+
+	characters_end();
+#endif
+
+	// a new layout does not cover the old one.
+	if (hour_digits != g_hour_digits)
+	{
+		vgfx_fb_clear();
+		g_hour_digits = hour_digits;
+		changed = DIGITS_ALL;
+	}
 
-	gfx_image_at(21, 6, digit5x8_ptr(t.mins / 10), 5);
-	gfx_image_at(27, 6, digit5x8_ptr(t.mins % 10), 5);
+	uint8_t x = TIME_MINS_X;
+
+	if (hour_digits != 0)
+	{
+		// hours, two separators and four digits, less the space after the last digit.
+		uint8_t width = (hour_digits + 4) * FONT5X8_ADVANCE + 2 * SEPARATOR_ADVANCE - 1;
+		x = (OLED_PIXEL_COLUMNS - width) / 2;
+	}
+
+	// left to right, the digits are held units first.
+	for (uint8_t i = hour_digits + 4; i-- != 0; )
+	{
+		if (changed & (1 << i))
+			display_paged(x, digit5x8_paged_ptr(digits[i]), DIGIT5X8_COLUMNS);
 
-	display_time_separator();
+		x += FONT5X8_ADVANCE;
 
-	gfx_image_at(35, 6, digit5x8_ptr(t.secs/ 10), 5);
-	gfx_image_at(41, 6, digit5x8_ptr(t.secs % 10), 5);
+		if (i == 4)
+		{
+			// after the hours.
+			if (changed == DIGITS_ALL)
+				display_paged(x, &g_separator[0], 1);
+
+			x += SEPARATOR_ADVANCE;
+		}
+		else if (i == 2)
+		{
+			// after the mins, redrawn each second as it blinks.
+			g_separator_x = x;
+			display_time_separator();
+			x += SEPARATOR_ADVANCE;
+		}
+	}
 }
 
-// displays the time vertical centered. (16 pixels in Y axis).
-void display_number(uint16_t seconds)
+// draws the changed number digits vertical centered to the framebuffer. (16 pixels in Y axis).
+void display_number(uint8_t const * digits, uint8_t changed)
 {
-	secs_base10_t secs = seconds_to_base10(seconds);
+	uint8_t number_digits = digits[5] ? 6 : digits[4] ? 5 : digits[3] ? 4 : 3;
 
-	if (secs.ten_thousands != 0)
-		gfx_image_at(14, 6, digit5x8_ptr(secs.ten_thousands), 5);
+	characters_end();
 
-	if (seconds >= 1000)
+	// a shorter number does not cover the longer one.
+	if (number_digits < g_number_digits)
 	{
-		gfx_image_at(20, 6, digit5x8_ptr(secs.thousands), 5);
-		gfx_image_at(26, 6, &g_comma[0], 2);
+		vgfx_fb_clear();
+		changed = DIGITS_ALL;
 	}
 
-	gfx_image_at(29, 6, digit5x8_ptr(secs.hundreds), 5);
-	gfx_image_at(35, 6, digit5x8_ptr(secs.tens), 5);
-	gfx_image_at(41, 6, digit5x8_ptr(secs.units), 5);
+	g_number_digits = number_digits;
+
+	for (uint8_t i = 0; i != number_digits; i++)
+	{
+		if (changed & (1 << i))
+		{
+			// the units are right aligned, the thousands left of the comma.
+			uint8_t x = (i < 3) ? NUMBER_UNITS_X - i * FONT5X8_ADVANCE : NUMBER_THOUSANDS_X - (i - 3) * FONT5X8_ADVANCE;
+			display_paged(x, digit5x8_paged_ptr(digits[i]), DIGIT5X8_COLUMNS);
+		}
+	}
+
+	// the comma goes with the thousands.
+	if (number_digits > 3 && (changed & 0x38))
+		display_paged(26, &g_comma[0], 2);
 }
 
-// displays the time separator symbol.
+// draws the time separator symbol to the framebuffer.
 void display_time_separator(void)
 {
-	gfx_pixels_at(33, 6, 0x22);
+	if (g_characters)
+		oled_write_character(CHAR_SEPARATOR_CODE, g_char_separator_column, CHAR_ROW);
+	else
+		display_paged(g_separator_x, &g_separator[0], 1);
 }
 
-// clears the time separator symbol.
+// clears the time separator symbol in the framebuffer.
 void clear_time_separator(void)
 {
-	oled_write_pixels_at(33, 1, 0x00);
-	oled_write_pixels_at(33, 2, 0x00);
+	if (g_characters)
+		oled_write_character(' ', g_char_separator_column, CHAR_ROW);
+	else
+		display_paged(g_separator_x, &g_space[0], 1);
+}
+
+// draws an image split into pages at the digit baseline to the framebuffer.
+void display_paged(uint8_t x, uint8_t const * const image, uint8_t columns)
+{
+	vgfx_fb_paged_at_P(x, DIGIT5X8_PAGE, image, columns, DIGIT5X8_MASK);
+}
+
+
+
+// writes the framebuffer changes to the display, in character mode the time is already written.
+void display_flush(void)
+{
+	if (!g_characters)
+		vgfx_flush();
+}
+
+// switches the display to character mode for the time, the separator is loaded the first time.
+// the time row is written in full by the next character_time().
+void characters_begin(void)
+{
+	if (g_characters)
+		return;
+
+	oled_character_mode();
+
+	if (!g_char_loaded)
+	{
+		oled_set_character_P(CHAR_SEPARATOR, &g_char_separator[0]);
+		g_char_loaded = true;
+	}
+
+	uint8_t blank[OLED_CHARACTER_COLUMNS];
+	memset(blank, ' ', sizeof(blank));
+	oled_write_characters(blank, sizeof(blank), 1, CHAR_BLANK_ROW);
+
+	g_characters = true;
+	g_hour_digits = DIGITS_ALL;
+}
+
+// switches the display back to graphics mode, the next flush writes the whole framebuffer.
+void characters_end(void)
+{
+	if (!g_characters)
+		return;
+
+	oled_graphics_mode();
+	vgfx_invalidate();
+
+	g_characters = false;
+	g_hour_digits = DIGITS_ALL;
 }
 
+// draws the changed time digits in character mode, each digit is a single DDRAM write.
+// the character row is centered, mm:ss below an hour then h:mm:ss and hh:mm:ss.
+// the changed digits and the mins separator (it blinks) are written as one run.
+void character_time(uint8_t const * digits, uint8_t changed, uint8_t hour_digits)
+{
+	uint8_t row[OLED_CHARACTER_COLUMNS];
+	memset(row, ' ', sizeof(row));
+
+	// a new layout is written across the whole row.
+	if (hour_digits != g_hour_digits)
+	{
+		g_hour_digits = hour_digits;
+		changed = DIGITS_ALL;
+	}
+
+	uint8_t width = hour_digits ? hour_digits + 6 : 5;
+	uint8_t c = (OLED_CHARACTER_COLUMNS - width) / 2;
+	uint8_t first = (changed == DIGITS_ALL) ? 0 : OLED_CHARACTER_COLUMNS;
+	uint8_t last = (changed == DIGITS_ALL) ? OLED_CHARACTER_COLUMNS - 1 : 0;
+
+	// left to right, the digits are held units first.
+	for (uint8_t i = hour_digits + 4; i-- != 0; )
+	{
+		row[c] = '0' + digits[i];
+
+		if ((changed & (1 << i)) && c < first)
+			first = c;
+
+		if ((changed & (1 << i)) && c > last)
+			last = c;
 
+		c++;
+
+		if (i == 4)
+		{
+			row[c++] = CHAR_SEPARATOR_CODE;
+		}
+		else if (i == 2)
+		{
+			// after the mins, shown again each second as it blinks.
+			row[c] = CHAR_SEPARATOR_CODE;
+			g_char_separator_column = c + 1;
+
+			if (c < first)
+				first = c;
+
+			if (c > last)
+				last = c;
+
+			c++;
+		}
+	}
+
+	oled_write_characters(&row[first], last - first + 1, first + 1, CHAR_ROW);
+}
+
+// draws the lap review rows, only the laps shown are drawn.
+void display_laps(void)
+{
+	uint16_t count = laps_count();
+
+	characters_end();
+
+	if (count == 0)
+	{
+		vgfx_fb_text_at_P((OLED_PIXEL_COLUMNS - 7 * FONT5X8_ADVANCE) / 2 + 1, 5, &g_no_laps[0]);
+		return;
+	}
+
+	for (uint8_t row = 0; row != LAP_ROWS && g_review_lap + row <= count; row++)
+	{
+		display_lap_row(row * 8 + 1, g_review_lap + row);
+	}
+}
+
+// draws a lap review row, the lap number then its split.
+// mm:ss.t below an hour, h:mm:ss from then.
+void display_lap_row(uint8_t y, uint16_t lap)
+{
+	char text[8];
+	uint32_t n = lap;
+
+	// the lap number, two digits (see LAPS_MAX).
+	uint8_t units = divide_u8(&n, 10);
+	uint8_t tens = divide_u8(&n, 10);
+
+	text[0] = (lap >= 10) ? '0' + tens : ' ';
+	text[1] = '0' + units;
+	text[2] = '\0';
+	display_row_text(LAP_NUMBER_X, y, text);
+
+	n = laps_split(lap);
+	uint8_t centisecs = divide_u8(&n, 100);
+
+	if (n > LAP_SPLIT_MAX)
+	{
+		n = LAP_SPLIT_MAX;
+	}
+
+	time_t t = seconds_to_time(n);
+
+	if (t.hours == 0)
+	{
+		text[0] = '0' + t.mins / 10;
+		text[1] = '0' + t.mins % 10;
+		text[2] = ':';
+		text[3] = '0' + t.secs / 10;
+		text[4] = '0' + t.secs % 10;
+		text[5] = '.';
+		text[6] = '0' + centisecs / 10;
+	}
+	else
+	{
+		text[0] = '0' + t.hours;
+		text[1] = ':';
+		text[2] = '0' + t.mins / 10;
+		text[3] = '0' + t.mins % 10;
+		text[4] = ':';
+		text[5] = '0' + t.secs / 10;
+		text[6] = '0' + t.secs % 10;
+	}
+
+	text[7] = '\0';
+	display_row_text(LAP_SPLIT_X, y, text);
+}
+
+// draws text in the 5x8 font to the framebuffer with narrow ':' and '.' marks.
+void display_row_text(uint8_t x, uint8_t y, char const * text)
+{
+	for (; *text != '\0'; text++)
+	{
+		if (*text == ':' || *text == '.')
+		{
+			vgfx_fb_image_at_P(x, y, (*text == ':') ? &g_row_colon[0] : &g_row_point[0], 1);
+			x += SEPARATOR_ADVANCE;
+		}
+		else
+		{
+			vgfx_fb_image_at_P(x, y, font5x8_ptr(*text), FONT5X8_COLUMNS);
+			x += FONT5X8_ADVANCE;
+		}
+	}
+}
+
+// returns the lap shown on the top row to show the newest laps.
+uint16_t review_newest(void)
+{
+	uint16_t count = laps_count();
+
+	return (count > LAP_ROWS) ? count - LAP_ROWS + 1 : 1;
+}
@@ -9,11 +9,31 @@
 #ifndef TIMER_H_
 #define TIMER_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "persist.h"
+
+// milliseconds between checks of the count for a redraw (timer_process).
+#define TIMER_REDRAW_MS 20
+
 // configure the timer.
 void timer_config(void);
 void timer_show(void);
+void timer_hide(void);
 void timer_process(void);
 void timer_action(void);
+void timer_reset(void);
 void timer_switch(void);
+bool timer_counting(void);
+
+// records a lap while counting, otherwise switches between the displays.
+void timer_alt_action(uint16_t pressed_ms);
+
+// records a lap while counting, pressed_ms is the tick time the lap button was pressed (see tick.h).
+void timer_lap(uint16_t pressed_ms);
+
+// state kept over a power cycle (see persist.h).
+void timer_save(persist_state_t * state);
+void timer_restore(persist_state_t const * state);
 
 #endif /* TIMER_H_ */
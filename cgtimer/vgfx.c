@@ -7,9 +7,38 @@
 
 #include "vgfx.h"
 #include "cgoled.h"
+#include "font5x8.h"
+#include "clock.h"
+#include <stdbool.h>
+#include <avr/pgmspace.h>
+
+// framebuffer dirty column bitmap size (bytes per page).
+#define FB_DIRTY_BYTES ((OLED_PIXEL_COLUMNS + 7) / 8)
+
+// largest run of unchanged columns written through during a flush.
+// writing one unchanged byte is cheaper than the two coordinate commands.
+#define FB_FLUSH_MAX_GAP 1
+
+// the framebuffer being drawn and a copy of what the display shows.
+static uint8_t g_fb[OLED_BYTE_ROWS][OLED_PIXEL_COLUMNS];
+static uint8_t g_fb_panel[OLED_BYTE_ROWS][OLED_PIXEL_COLUMNS];
+
+// columns changed since the last flush (1 bit per column).
+static uint8_t g_fb_dirty[OLED_BYTE_ROWS][FB_DIRTY_BYTES];
+
+// false until the display contents are known.
+static bool g_fb_panel_valid = false;
 
 // function declarations.
 uint8_t buffer_index(uint8_t xsize, uint8_t x, uint8_t y);
+void fb_set(uint8_t page, uint8_t column, uint8_t pixels);
+void buffer_or(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y, bool progmem);
+void fb_buffer_at(uint8_t const * const buffer, uint8_t buffer_columns, uint8_t x, bool progmem);
+void fb_text_at(uint8_t x, uint8_t y, char const * text, bool progmem);
+void fb_draw(uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y, bool replace, bool progmem);
+static inline uint8_t read_pixels(uint8_t const * ptr, bool progmem);
+void fb_mark_all_dirty(void);
+void fb_write_run(uint8_t page, uint8_t start, uint8_t end);
 
 
 // clear the contents of the buffer.
@@ -24,6 +53,18 @@ void vgfx_buffer_clear(uint8_t * buffer, uint8_t size)
 
 // set pixels in buffer.
 void vgfx_buffer_or(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y)
+{
+	buffer_or(buffer, buffer_columns, pixel_bytes, columns, x, y, false);
+}
+
+// set pixels in buffer from pixel bytes held in program memory.
+void vgfx_buffer_or_P(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y)
+{
+	buffer_or(buffer, buffer_columns, pixel_bytes, columns, x, y, true);
+}
+
+// set pixels in buffer from data memory or program memory (progmem).
+void buffer_or(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y, bool progmem)
 {
 	// calculate the buffer y-axis position based on the pixel y co-ordinate. (one based)
 	uint8_t buf_y = y / 8;
@@ -58,7 +99,7 @@ void vgfx_buffer_or(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * co
 			pix_ptr++;
 		}
 
-		*buf_ptr |= (*pix_ptr) << shift_n;
+		*buf_ptr |= read_pixels(pix_ptr, progmem) << shift_n;
 	}
 
 	if (shift_n != 0)
@@ -80,7 +121,7 @@ void vgfx_buffer_or(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * co
 					pix_ptr++;
 				}
 
-				*buf_ptr |= (*pix_ptr) >> shift_n;
+				*buf_ptr |= read_pixels(pix_ptr, progmem) >> shift_n;
 			}
 		}
 	}
@@ -90,22 +131,10 @@ void vgfx_buffer_or(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * co
 void vgfx_buffer_display_at(uint8_t const * const buffer, uint8_t buffer_columns, uint8_t x)
 {
 	oled_set_coordinates(x, 1);
-
-	uint8_t const * ptr = buffer;
-	
-	for (uint8_t i = 0; i != buffer_columns; i++)
-	{
-		oled_write_data(*ptr);
-		ptr++;
-	}
+	oled_write_data_n(buffer, buffer_columns);
 	
 	oled_set_coordinates(x, 2);
-
-	for (uint8_t i = 0; i != buffer_columns; i++)
-	{
-		oled_write_data(*ptr);
-		ptr++;
-	}
+	oled_write_data_n(buffer + buffer_columns, buffer_columns);
 }
 
 
@@ -125,3 +154,270 @@ uint8_t buffer_index(uint8_t xsize, uint8_t x, uint8_t y)
 
 	return index;
 }
+
+
+// clear the framebuffer.
+void vgfx_fb_clear(void)
+{
+	for (uint8_t page = 0; page != OLED_BYTE_ROWS; page++)
+	{
+		for (uint8_t column = 0; column != OLED_PIXEL_COLUMNS; column++)
+		{
+			fb_set(page, column, 0x00);
+		}
+	}
+}
+
+// set pixels in the framebuffer (or'd with the existing pixels).
+void vgfx_fb_or(uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y)
+{
+	fb_draw(pixel_bytes, columns, x, y, false, false);
+}
+
+// draws a single column of 8 pixel rows at the given pixel co-ordinates.
+// the 8 pixel rows covered are replaced.
+void vgfx_fb_pixels_at(uint8_t x, uint8_t y, uint8_t pixels)
+{
+	fb_draw(&pixels, 1, x, y, true, false);
+}
+
+// draws an image at the given pixel co-ordinates.
+// the image is 8 rows of pixels, the 8 pixel rows covered are replaced.
+void vgfx_fb_image_at(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns)
+{
+	fb_draw(image, columns, x, y, true, false);
+}
+
+// draws an image held in program memory at the given pixel co-ordinates.
+// the image is 8 rows of pixels, the 8 pixel rows covered are replaced.
+void vgfx_fb_image_at_P(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns)
+{
+	fb_draw(image, columns, x, y, true, true);
+}
+
+// draws a two page buffer (see vgfx_buffer_display_at) at the given x co-ordinate.
+void vgfx_fb_buffer_at(uint8_t const * const buffer, uint8_t buffer_columns, uint8_t x)
+{
+	fb_buffer_at(buffer, buffer_columns, x, false);
+}
+
+// draws a two page buffer held in program memory at the given x co-ordinate.
+void vgfx_fb_buffer_at_P(uint8_t const * const buffer, uint8_t buffer_columns, uint8_t x)
+{
+	fb_buffer_at(buffer, buffer_columns, x, true);
+}
+
+// draws the text at the given pixel co-ordinates using the 5x8 font.
+void vgfx_fb_text_at(uint8_t x, uint8_t y, char const * text)
+{
+	fb_text_at(x, y, text, false);
+}
+
+// draws text held in program memory at the given pixel co-ordinates using the 5x8 font.
+void vgfx_fb_text_at_P(uint8_t x, uint8_t y, char const * text)
+{
+	fb_text_at(x, y, text, true);
+}
+
+// writes the bytes that differ from what the display already shows.
+// changed columns are written in runs, short gaps of unchanged columns join runs.
+void vgfx_flush(void)
+{
+	// the writes are made at the fast clock.
+	clock_fast();
+
+	if (!g_fb_panel_valid)
+	{
+		fb_mark_all_dirty();
+	}
+
+	for (uint8_t page = 0; page != OLED_BYTE_ROWS; page++)
+	{
+		uint8_t const * fb = &g_fb[page][0];
+		uint8_t * panel = &g_fb_panel[page][0];
+		uint8_t * dirty = &g_fb_dirty[page][0];
+
+		// run of columns to write [run_start, run_end), empty when equal.
+		uint8_t run_start = 0;
+		uint8_t run_end = 0;
+
+		for (uint8_t column = 0; column != OLED_PIXEL_COLUMNS; column++)
+		{
+			uint8_t bit = 1 << (column & 7);
+
+			if (!(dirty[column >> 3] & bit))
+				continue;
+
+			dirty[column >> 3] &= ~bit;
+
+			if (g_fb_panel_valid && fb[column] == panel[column])
+				continue;
+
+			panel[column] = fb[column];
+
+			if (run_start != run_end && column - run_end <= FB_FLUSH_MAX_GAP)
+			{
+				// unchanged columns in the gap are re-written instead of moving the cursor.
+				run_end = column + 1;
+				continue;
+			}
+
+			fb_write_run(page, run_start, run_end);
+			run_start = column;
+			run_end = column + 1;
+		}
+
+		fb_write_run(page, run_start, run_end);
+	}
+
+	g_fb_panel_valid = true;
+
+	clock_slow();
+}
+
+// forgets what the display shows, the next flush writes every byte.
+void vgfx_invalidate(void)
+{
+	g_fb_panel_valid = false;
+}
+
+
+// draws an image held in program memory that is already split into two pages.
+void vgfx_fb_paged_at_P(uint8_t x, uint8_t page, uint8_t const * const image, uint8_t columns, uint8_t mask)
+{
+	// zero based page and column.
+	page--;
+	uint8_t column = x - 1;
+
+	for (uint8_t i = 0; i != columns && column < OLED_PIXEL_COLUMNS; i++, column++)
+	{
+		fb_set(page, column, (g_fb[page][column] & ~mask) | pgm_read_byte(&image[i]));
+
+		if (page + 1 < OLED_BYTE_ROWS)
+		{
+			fb_set(page + 1, column, (g_fb[page + 1][column] & mask) | pgm_read_byte(&image[columns + i]));
+		}
+	}
+}
+
+// draws the glyphs of text from data memory or program memory (progmem).
+// the blank column between characters is drawn too, so the text replaces what was there.
+void fb_text_at(uint8_t x, uint8_t y, char const * text, bool progmem)
+{
+	char c = read_pixels((uint8_t const *)text, progmem);
+
+	while (c != '\0' && x <= OLED_PIXEL_COLUMNS)
+	{
+		fb_draw(font5x8_ptr(c), FONT5X8_COLUMNS, x, y, true, true);
+		x += FONT5X8_COLUMNS;
+
+		text++;
+		c = read_pixels((uint8_t const *)text, progmem);
+
+		if (c != '\0' && x <= OLED_PIXEL_COLUMNS)
+		{
+			vgfx_fb_pixels_at(x, y, 0x00);
+			x++;
+		}
+	}
+}
+
+// draws a two page buffer from data memory or program memory (progmem).
+void fb_buffer_at(uint8_t const * const buffer, uint8_t buffer_columns, uint8_t x, bool progmem)
+{
+	uint8_t const * ptr = buffer;
+
+	for (uint8_t page = 0; page != OLED_BYTE_ROWS; page++)
+	{
+		uint8_t column = x - 1;
+
+		for (uint8_t i = 0; i != buffer_columns; i++)
+		{
+			if (column < OLED_PIXEL_COLUMNS)
+			{
+				fb_set(page, column, read_pixels(ptr, progmem));
+			}
+
+			column++;
+			ptr++;
+		}
+	}
+}
+
+
+// sets a framebuffer byte, marking the column dirty when it changes.
+// page and column are zero based.
+void fb_set(uint8_t page, uint8_t column, uint8_t pixels)
+{
+	if (g_fb[page][column] != pixels)
+	{
+		g_fb[page][column] = pixels;
+		g_fb_dirty[page][column >> 3] |= (1 << (column & 7));
+	}
+}
+
+// draws 8 pixel rows per column into the framebuffer.
+// replace clears the covered rows first, otherwise the pixels are or'd.
+void fb_draw(uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y, bool replace, bool progmem)
+{
+	// calculate the page based on the pixel y co-ordinate. (zero based)
+	uint8_t page = y / 8;
+	uint8_t mod = y % 8;
+	uint8_t shift_n = 0;
+
+	if (mod == 0)
+	{
+		page--;
+		shift_n = 7;
+	}
+	else
+	{
+		shift_n = mod - 1;
+	}
+
+	// covered rows in the first and second page.
+	uint8_t mask1 = replace ? (0xFF << shift_n) : 0x00;
+	uint8_t mask2 = replace ? (0xFF >> (8 - shift_n)) : 0x00;
+
+	uint8_t column = x - 1;
+
+	for (uint8_t i = 0; i != columns && column < OLED_PIXEL_COLUMNS; i++, column++)
+	{
+		uint8_t pixels = read_pixels(&pixel_bytes[i], progmem);
+
+		fb_set(page, column, (g_fb[page][column] & ~mask1) | (pixels << shift_n));
+
+		if (shift_n != 0 && page + 1 < OLED_BYTE_ROWS)
+		{
+			fb_set(page + 1, column, (g_fb[page + 1][column] & ~mask2) | (pixels >> (8 - shift_n)));
+		}
+	}
+}
+
+// marks every framebuffer column dirty.
+void fb_mark_all_dirty(void)
+{
+	for (uint8_t page = 0; page != OLED_BYTE_ROWS; page++)
+	{
+		for (uint8_t i = 0; i != FB_DIRTY_BYTES; i++)
+		{
+			g_fb_dirty[page][i] = 0xFF;
+		}
+	}
+}
+
+// writes framebuffer columns [start, end) of the page to the display.
+void fb_write_run(uint8_t page, uint8_t start, uint8_t end)
+{
+	if (start == end)
+		return;
+
+	oled_set_coordinates(start + 1, page + 1);
+	oled_write_data_n(&g_fb[page][start], end - start);
+}
+
+// reads a byte of pixels from data memory or program memory (progmem).
+static inline uint8_t read_pixels(uint8_t const * ptr, bool progmem)
+{
+	return progmem ? pgm_read_byte(ptr) : *ptr;
+}
@@ -17,7 +17,59 @@ void vgfx_buffer_clear(uint8_t * buffer, uint8_t size);
 // set pixels in buffer.
 void vgfx_buffer_or(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y);
 
+// set pixels in buffer from pixel bytes held in program memory (PROGMEM).
+void vgfx_buffer_or_P(uint8_t * buffer, uint8_t buffer_columns, uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y);
+
 // display the buffer at the given x co-ordinate.
 void vgfx_buffer_display_at(uint8_t const * const buffer, uint8_t buffer_columns, uint8_t x);
 
+
+// Full screen shadow framebuffer.
+//
+// The framebuffer is laid out page by page to match the controller's graphics RAM.
+// Page 1 holds pixel rows 1 to 8 and page 2 holds pixel rows 9 to 16.
+// Drawing only changes the framebuffer, vgfx_flush() writes the changes to the display.
+
+// clear the framebuffer.
+void vgfx_fb_clear(void);
+
+// set pixels in the framebuffer (or'd with the existing pixels).
+void vgfx_fb_or(uint8_t const * const pixel_bytes, uint8_t columns, uint8_t x, uint8_t y);
+
+// draws a single column of 8 pixel rows at the given pixel co-ordinates.
+// the 8 pixel rows covered are replaced.
+void vgfx_fb_pixels_at(uint8_t x, uint8_t y, uint8_t pixels);
+
+// draws an image at the given pixel co-ordinates.
+// the image is 8 rows of pixels, the 8 pixel rows covered are replaced.
+void vgfx_fb_image_at(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns);
+
+// draws an image held in program memory (PROGMEM) at the given pixel co-ordinates.
+void vgfx_fb_image_at_P(uint8_t x, uint8_t y, uint8_t const * const image, uint8_t columns);
+
+// draws a two page buffer (see vgfx_buffer_display_at) at the given x co-ordinate.
+void vgfx_fb_buffer_at(uint8_t const * const buffer, uint8_t buffer_columns, uint8_t x);
+
+// draws a two page buffer held in program memory (PROGMEM) at the given x co-ordinate.
+void vgfx_fb_buffer_at_P(uint8_t const * const buffer, uint8_t buffer_columns, uint8_t x);
+
+// draws the text at the given pixel co-ordinates using the 5x8 font (see font5x8.h).
+// the 8 pixel rows covered are replaced, the text is cut at the right edge.
+void vgfx_fb_text_at(uint8_t x, uint8_t y, char const * text);
+
+// draws text held in program memory (PROGMEM) at the given pixel co-ordinates.
+void vgfx_fb_text_at_P(uint8_t x, uint8_t y, char const * text);
+
+// draws an image held in program memory (PROGMEM) that is already split into pages (see numeric5x8.h).
+// the image columns for the given page (1 or 2) are followed by the columns for the next page.
+// mask is the pixel rows covered in the given page, the remaining rows are covered in the next page.
+// the pixel bytes are copied without shifting.
+void vgfx_fb_paged_at_P(uint8_t x, uint8_t page, uint8_t const * const image, uint8_t columns, uint8_t mask);
+
+// writes the bytes that differ from what the display already shows.
+void vgfx_flush(void);
+
+// forgets what the display shows, the next flush writes every byte.
+void vgfx_invalidate(void);
+
 #endif /* VGFX_H_ */